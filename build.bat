@@ -14,10 +14,10 @@ g++ -std=c++20 -Wall -fdiagnostics-color=always -static-libgcc -static-libstdc++
 -I src\imgui ^
 -I src\imgui-sfml ^
 main.cpp ^
-src\GameEngine.cpp src\Scene.cpp src\Scene_Play.cpp src\Scene_LevelEditor.cpp src\Scene_Menu.cpp ^
+src\GameEngine.cpp src\RenderThread.cpp src\DrawList.cpp src\Profiler.cpp src\Trace.cpp src\InputRecording.cpp src\Scene.cpp src\Scene_Play.cpp src\Scene_LevelEditor.cpp src\Scene_Menu.cpp ^
 src\systems\LoadLevel.cpp src\systems\PlayRenderer.cpp src\systems\CollisionSystem.cpp src\Scene_GameOver.cpp ^
 src\Assets.cpp src\systems\MovementSystem.cpp src\systems\AnimationSystem.cpp src\systems\EnemyAISystem.cpp ^
-src\systems\Spawner.cpp src\systems\DialogueSystem.cpp src\Scene_StoryText.cpp src\ResourcePath.cpp ^
+src\systems\Spawner.cpp src\systems\DialogueSystem.cpp src\systems\Broadphase.cpp src\systems\StaticBatch.cpp src\systems\LayerCompositor.cpp src\systems\SpriteBatch.cpp src\systems\OverlayBatch.cpp src\systems\ParallaxBackground.cpp src\Scene_StoryText.cpp src\ResourcePath.cpp ^
 src\imgui\imgui.cpp ^
 src\imgui\imgui_draw.cpp ^
 src\imgui\imgui_tables.cpp ^
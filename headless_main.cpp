@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GameEngine.h"
+#include "ResourcePath.h"
+#include "Trace.h"
+
+// Headless benchmark: runs a level's simulation with no window, no GL context
+// and no frame pacing, as fast as the machine allows.
+//
+//   sfml_headless <level> [--frames N] [--script file] [--seed N] [--trace=<file>]
+//   sfml_headless --replay <file> [--trace=<file>]
+//
+// <level> is a file in levels/ (or a path). The script feeds actions in as
+// if keys were pressed, one per line: "<step> <ACTION> <START|END>",
+// e.g. "0 MOVE_RIGHT START", "350 JUMP START". Lines starting with # are skipped.
+// --seed fixes the random numbers, so two runs of the same script match.
+//
+// --replay runs a session recorded with "sfml_app --record=<file>" (level,
+// seed and actions come from the file) and checks its checksums; it exits
+// with 2 if the simulation diverged from the recording.
+
+struct ScriptedAction {
+    long step = 0;
+    Action action;
+};
+
+static bool loadScript(const std::string& path, std::vector<ScriptedAction>& script) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[ERROR] Failed to open input script: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream stream(line);
+        ScriptedAction entry;
+        std::string name, type;
+        if (!(stream >> entry.step >> name >> type) || (type != "START" && type != "END")) {
+            std::cerr << "[WARNING] Skipping script line: " << line << std::endl;
+            continue;
+        }
+        entry.action = Action(name, type);
+        script.push_back(entry);
+    }
+
+    std::stable_sort(script.begin(), script.end(),
+                     [](const ScriptedAction& a, const ScriptedAction& b) { return a.step < b.step; });
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <level> [--frames N] [--script file] [--seed N] [--trace=<file>]\n"
+                  << "       " << argv[0] << " --replay <file> [--trace=<file>]" << std::endl;
+        return 1;
+    }
+
+    std::string level;
+    long steps = 6000;   // one minute of game time
+    std::vector<ScriptedAction> script;
+    std::string tracePath;
+    std::string replayPath;
+    bool seeded = false;
+    uint32_t seed = 0;
+
+    int first = 1;
+    if (argv[1][0] != '-') {
+        level = argv[1];
+        first = 2;
+    }
+    for (int i = first; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--frames" && i + 1 < argc) {
+            steps = std::stol(argv[++i]);
+        } else if (arg == "--script" && i + 1 < argc) {
+            if (!loadScript(argv[++i], script)) return 1;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+            seeded = true;
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg.rfind("--trace=", 0) == 0 && arg.size() > 8) {
+            tracePath = arg.substr(8);
+        } else {
+            std::cerr << "[WARNING] Unknown option: " << arg << std::endl;
+        }
+    }
+
+    if (replayPath.empty()) {
+        if (level.empty()) {
+            std::cerr << "[ERROR] No level given" << std::endl;
+            return 1;
+        }
+        if (!std::filesystem::exists(level)) {
+            level = getResourcePath("levels") + "/" + level;
+        }
+        if (!std::filesystem::exists(level)) {
+            std::cerr << "[ERROR] Level file does not exist: " << level << std::endl;
+            return 1;
+        }
+    }
+
+    if (!tracePath.empty()) {
+        Trace::start();
+        Trace::setThreadName("main");
+    }
+
+    GameEngine game(getResourcePath("assets/assets.txt"), true);
+
+    auto loadStart = std::chrono::steady_clock::now();
+    if (!replayPath.empty()) {
+        if (!game.startReplay(replayPath)) return 1;
+        level = game.getCurrentLevel();
+        script.clear();
+    } else {
+        if (seeded) game.random().reseed(seed);
+        game.loadLevel(level);
+    }
+    double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
+
+    // Each scene change is a death (restart) or a level exit
+    std::shared_ptr<Scene> scene = game.getCurrentScene();
+    int sceneChanges = 0;
+    size_t next = 0;
+    long step = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    bool replaying = !replayPath.empty();
+    for (; (replaying ? !game.replayFinished() : step < steps) && game.isRunning(); ++step) {
+        while (next < script.size() && script[next].step <= step) {
+            game.pushAction(script[next].action);
+            ++next;
+        }
+
+        game.step();
+
+        if (game.getCurrentScene() != scene) {
+            scene = game.getCurrentScene();
+            ++sceneChanges;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Level:         " << level << "\n"
+              << "Load:          " << loadSeconds * 1000.0 << " ms\n"
+              << "Steps:         " << step << " (" << step * GameEngine::FIXED_STEP << " s of game time)\n"
+              << "Wall time:     " << seconds << " s\n"
+              << "Steps/s:       " << (seconds > 0.0 ? step / seconds : 0.0) << "\n"
+              << "Avg step:      " << (step > 0 ? seconds * 1e6 / step : 0.0) << " us\n"
+              << "Scene changes: " << sceneChanges << " (restarts and level exits)\n"
+              << "Final level:   " << game.getCurrentLevel() << std::endl;
+
+    int result = 0;
+    if (replaying) {
+        std::cout << "Checksums:     " << game.replayChecksumsMatched() << " matched";
+        if (game.replayDivergedAt() != 0) {
+            std::cout << ", diverged at step " << game.replayDivergedAt();
+            result = 2;
+        }
+        std::cout << std::endl;
+    }
+
+#if PROFILER_ENABLED
+    const Profiler& profiler = game.profiler();
+    std::cout << "Systems, average ms per step over the last " << profiler.frames() << " steps:\n";
+    for (size_t index = 0; index < PROFILE_ZONE_COUNT; ++index) {
+        ProfileZone zone = static_cast<ProfileZone>(index);
+        if (zone == ProfileZone::Render) continue;   // nothing is drawn
+        std::cout << "  " << profileZoneName(zone) << ": " << profiler.average(zone) << "\n";
+    }
+#endif
+
+    if (!tracePath.empty()) {
+        Trace::write(tracePath);
+    }
+    return result;
+}
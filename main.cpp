@@ -1,12 +1,47 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
+#include <string>
 #include "GameEngine.h"
 #include "ResourcePath.h"
+#include "Trace.h"
+
+int main(int argc, char* argv[]) {
+    // --render-thread: draw the play scene on its own thread
+    // --trace=<file>: record a timeline of the frames, written on exit (chrome://tracing, Perfetto)
+    // --record=<file>: record the inputs of the first level played, for sfml_headless --replay
+    bool renderThread = false;
+    std::string tracePath;
+    std::string recordPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--render-thread") {
+            renderThread = true;
+        } else if (arg.rfind("--trace=", 0) == 0 && arg.size() > 8) {
+            tracePath = arg.substr(8);
+        } else if (arg.rfind("--record=", 0) == 0 && arg.size() > 9) {
+            recordPath = arg.substr(9);
+        } else {
+            std::cerr << "[WARNING] Unknown option: " << arg << std::endl;
+        }
+    }
+
+    if (!tracePath.empty()) {
+        Trace::start();
+        Trace::setThreadName("main");
+    }
 
-int main() {
     // Initialize the GameEngine with the assets configuration file
     GameEngine g(getResourcePath("assets/assets.txt"));
+    g.setRenderThreaded(renderThread);
+    if (!recordPath.empty()) {
+        g.recordTo(recordPath);
+    }
 
     // Start the game loop
     g.run();
+
+    // The render thread was stopped with the game
+    if (!tracePath.empty()) {
+        Trace::write(tracePath);
+    }
 }
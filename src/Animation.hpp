@@ -27,10 +27,21 @@ public:
               int speed,      // frames per second
               bool repeat = true, 
               const std::string& name = "")
-        : m_speed(speed), m_repeat(repeat), m_name(name)
+        : Animation(frameWidth, frameHeight, frameCount, speed, repeat, name)
     {
-        m_sprite.setTexture(texture);
+        m_sprite.setTexture(texture);   // keeps the frame's texture rect
+    }
 
+    // Frames and timing only, no texture (headless Assets): sizes and
+    // animation state behave the same, there is just nothing to draw
+    Animation(int frameWidth, 
+              int frameHeight, 
+              int frameCount, 
+              int speed,      // frames per second
+              bool repeat = true, 
+              const std::string& name = "")
+        : m_speed(speed), m_repeat(repeat), m_name(name)
+    {
         // Fill out the vector of frames (all on one row)
         for (int i = 0; i < frameCount; ++i) {
             m_frames.emplace_back(i * frameWidth, 0, frameWidth, frameHeight);
@@ -96,6 +107,19 @@ public:
     int getCurrentFrame()    const { return m_currentFrame; }
     bool hasEnded()          const { return !m_repeat && m_currentFrame == (int)m_frames.size()-1; }
 
+    // Point the frames at a texture atlas page; `offset` is where this
+    // animation's texture was packed (Assets::buildAtlases)
+    void setAtlasRegion(const sf::Texture& page, sf::Vector2i offset) {
+        for (auto& frame : m_frames) {
+            frame.left += offset.x;
+            frame.top  += offset.y;
+        }
+        m_sprite.setTexture(page);
+        if (!m_frames.empty()) {
+            m_sprite.setTextureRect(m_frames[m_currentFrame]);
+        }
+    }
+
     // Accessors for drawing
     const sf::Sprite& getSprite()  const { return m_sprite; }
     sf::Sprite& getMutableSprite()       { return m_sprite; }
@@ -2,16 +2,28 @@
 #include <iostream>
 #include <fstream>
 #include "ResourcePath.h"
+#include <algorithm>
+#include <filesystem>
+
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
 
 // Constructor: Initialize default assets
-Assets::Assets() {
-    // Create a 1x1 white texture
-    m_defaultTexture.create(1, 1);
-    sf::Uint8 whitePixel[4] = {255, 255, 255, 255};  // RGBA (White)
-    m_defaultTexture.update(whitePixel, 1, 1, 0, 0);
+Assets::Assets(bool headless)
+    : m_headless(headless)
+{
+    if (m_headless) {
+        m_defaultAnimation = Animation(1, 1, 1, 0);
+    } else {
+        // Create a 1x1 white texture
+        m_defaultTexture = std::make_unique<sf::Texture>();
+        m_defaultTexture->create(1, 1);
+        sf::Uint8 whitePixel[4] = {255, 255, 255, 255};  // RGBA (White)
+        m_defaultTexture->update(whitePixel, 1, 1, 0, 0);
 
-    // Default Animation
-    m_defaultAnimation = Animation(m_defaultTexture, 1, 1, 1, 0);
+        // Default Animation
+        m_defaultAnimation = Animation(*m_defaultTexture, 1, 1, 1, 0);
+    }
 
     // Default Font (Avoid crash if fonts are missing)
     if (!m_defaultFont.loadFromFile(getResourcePath("fonts/default.ttf"))) {
@@ -26,13 +38,26 @@ const Animation& Assets::getDefaultAnimation() const {
 
 // Load and store textures
 void Assets::addTexture(const std::string& name, const std::string& path) {
+    if (m_headless) {
+        // Only remembered, so animations know their texture exists
+        if (!std::filesystem::exists(getResourcePath("images/" + path))) {
+            std::cerr << "[Warning] Failed to load texture: " << getResourcePath("images/" + path) << ".\n";
+            return;
+        }
+        m_texturePaths[name] = path;
+        return;
+    }
+
+    sf::Image image;
     sf::Texture texture;
-    if (!texture.loadFromFile(getResourcePath("images/" + path))) {
+    if (!image.loadFromFile(getResourcePath("images/" + path)) || !texture.loadFromImage(image)) {
         std::cerr << "[Warning] Failed to load texture: " << getResourcePath("images/" + path) << ". Using default.\n";
-        m_textureMap[name] = m_defaultTexture;
+        m_textureMap[name] = *m_defaultTexture;
         return;
     }
     m_textureMap[name] = std::move(texture);
+    m_texturePaths[name] = path;
+    m_pendingImages[name] = std::move(image);   // kept for the atlas
 }
 
 // Load and store fonts
@@ -55,6 +80,24 @@ void Assets::addAnimation(const std::string& name,
                           int frameCount, 
                           int fps)
 {
+    if (m_headless) {
+        if (!m_texturePaths.count(textureName)) {
+            m_animationMap[name] = m_defaultAnimation;
+            return;
+        }
+        m_animationMap[name] = Animation(frameWidth, frameHeight, frameCount, fps, true, name);
+        return;
+    }
+
+    // Added after the atlas was built: its texture may only live on a page
+    auto region = m_atlasRegions.find(textureName);
+    if (region != m_atlasRegions.end()) {
+        m_animationMap[name] = Animation(frameWidth, frameHeight, frameCount, fps, true, name);
+        m_animationMap[name].setAtlasRegion(*region->second.page, region->second.offset);
+        m_animationTextures[name] = textureName;
+        return;
+    }
+
     auto it = m_textureMap.find(textureName);
     if (it == m_textureMap.end()) {
         std::cerr << "[Warning] Texture " << textureName 
@@ -72,6 +115,111 @@ void Assets::addAnimation(const std::string& name,
                                      fps,       // frames/second
                                      true,      // repeating
                                      name);     // sets m_name to "PlayerRun", etc.
+    m_animationTextures[name] = textureName;
+}
+
+// World a texture belongs to, from its folder: textures of the same world end
+// up on the same pages, so a level mostly draws from one or two of them
+static std::string atlasGroup(const std::string& path) {
+    for (const char* world : {"ancient_rome", "future_rome", "alien_rome"}) {
+        if (path.find(world) != std::string::npos) return world;
+    }
+    return "common";
+}
+
+void Assets::buildAtlases() {
+    const unsigned pageSize = std::min(ATLAS_PAGE_SIZE, sf::Texture::getMaximumSize());
+
+    // Area each texture needs: its image, or more if frames run past its edge
+    // (they sampled transparent pixels before, they must not sample a neighbour now)
+    std::unordered_map<std::string, sf::Vector2u> extents;
+    for (const auto& [animName, textureName] : m_animationTextures) {
+        if (!m_pendingImages.count(textureName)) continue;
+        const Animation& animation = m_animationMap[animName];
+        sf::Vector2u& extent = extents.try_emplace(textureName, m_pendingImages[textureName].getSize()).first->second;
+        extent.x = std::max(extent.x, static_cast<unsigned>(animation.getSize().x * animation.getFrameCount()));
+        extent.y = std::max(extent.y, static_cast<unsigned>(animation.getSize().y));
+    }
+
+    // Only textures drawn through animations are packed; the others stay as they are
+    std::map<std::string, std::vector<std::pair<std::string, sf::Vector2u>>> groups;
+    for (const auto& [textureName, extent] : extents) {
+        if (extent.x + ATLAS_PADDING > pageSize || extent.y + ATLAS_PADDING > pageSize) continue;
+        groups[atlasGroup(m_texturePaths[textureName])].emplace_back(textureName, extent);
+    }
+    for (auto& [group, textures] : groups) {
+        // Sorted by name: the same pages on every run
+        std::sort(textures.begin(), textures.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        packAtlasPages(textures);
+    }
+
+    for (const auto& [animName, textureName] : m_animationTextures) {
+        auto region = m_atlasRegions.find(textureName);
+        if (region != m_atlasRegions.end()) {
+            m_animationMap[animName].setAtlasRegion(*region->second.page, region->second.offset);
+        }
+    }
+
+    // Packed textures are only drawn from their page now: free the standalone copies
+    for (const auto& [textureName, region] : m_atlasRegions) {
+        m_textureMap.erase(textureName);
+    }
+    m_pendingImages.clear();
+}
+
+// Fills as many pages as needed with `textures` (name, extent)
+void Assets::packAtlasPages(std::vector<std::pair<std::string, sf::Vector2u>>& textures) {
+    const int pageSize = static_cast<int>(std::min(ATLAS_PAGE_SIZE, sf::Texture::getMaximumSize()));
+
+    while (!textures.empty()) {
+        std::vector<stbrp_rect> rects(textures.size());
+        for (size_t i = 0; i < textures.size(); ++i) {
+            rects[i].id = static_cast<int>(i);
+            rects[i].w  = static_cast<stbrp_coord>(textures[i].second.x + ATLAS_PADDING);
+            rects[i].h  = static_cast<stbrp_coord>(textures[i].second.y + ATLAS_PADDING);
+        }
+        std::vector<stbrp_node> nodes(pageSize);
+        stbrp_context context;
+        stbrp_init_target(&context, pageSize, pageSize, nodes.data(), static_cast<int>(nodes.size()));
+        stbrp_pack_rects(&context, rects.data(), static_cast<int>(rects.size()));
+
+        // Page only as big as what landed on it
+        unsigned width = 0, height = 0;
+        for (const auto& rect : rects) {
+            if (!rect.was_packed) continue;
+            width  = std::max(width,  static_cast<unsigned>(rect.x + rect.w));
+            height = std::max(height, static_cast<unsigned>(rect.y + rect.h));
+        }
+        if (width == 0) {
+            std::cerr << "[WARNING] Atlas: " << textures.size() << " textures don't fit in a page, left unpacked\n";
+            return;
+        }
+
+        sf::Image pageImage;
+        pageImage.create(width, height, sf::Color::Transparent);
+        for (const auto& rect : rects) {
+            if (!rect.was_packed) continue;
+            pageImage.copy(m_pendingImages[textures[rect.id].first], rect.x, rect.y);
+        }
+        auto page = std::make_unique<sf::Texture>();
+        if (!page->loadFromImage(pageImage)) {
+            std::cerr << "[ERROR] Atlas: failed to create a " << width << "x" << height << " page\n";
+            return;
+        }
+
+        std::vector<std::pair<std::string, sf::Vector2u>> leftover;
+        for (const auto& rect : rects) {
+            const auto& texture = textures[rect.id];
+            if (rect.was_packed) {
+                m_atlasRegions[texture.first] = {page.get(), sf::Vector2i(rect.x, rect.y)};
+            } else {
+                leftover.push_back(texture);
+            }
+        }
+        m_atlasPages.push_back(std::move(page));
+        textures = std::move(leftover);
+    }
 }
 
 // Retrieve assets safely
@@ -79,7 +227,7 @@ const sf::Texture& Assets::getTexture(const std::string& name) const {
     auto it = m_textureMap.find(name);
     if (it == m_textureMap.end()) {
         std::cerr << "[ERROR] Texture '" << name << "' not found! Using default.\n";
-        return m_defaultTexture;
+        return *m_defaultTexture;
     }
     return it->second;
 }
@@ -140,7 +288,7 @@ void Assets::loadFromFile(const std::string& filePath) {
             int frameWidth, frameHeight, frameCount, fps;
             stream >> frameWidth >> frameHeight >> frameCount >> fps;
 
-            if (m_textureMap.find(textureName) == m_textureMap.end()) {
+            if (m_textureMap.find(textureName) == m_textureMap.end() && !m_texturePaths.count(textureName)) {
                 // std::cerr << "[WARNING] Missing texture: " 
                 //           << textureName << " for animation: " 
                 //           << name << std::endl;
@@ -157,6 +305,10 @@ void Assets::loadFromFile(const std::string& filePath) {
         }
     }
 
+    if (!m_headless) {
+        buildAtlases();
+    }
+
     // std::cout << "[DEBUG] Asset Loading Completed. Textures: " 
     //           << m_textureMap.size() << " | Animations: " 
     //           << m_animationMap.size() << " | Fonts: " 
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <unordered_map>
+#include <map>
+#include <vector>
+#include <memory>
 #include <string>
 #include <SFML/Graphics.hpp>
 #include <sstream> 
@@ -12,12 +15,32 @@ private:
     std::unordered_map<std::string, Animation> m_animationMap;
     std::unordered_map<std::string, sf::Font> m_fontMap;
 
-    sf::Texture m_defaultTexture;
+    // Texture atlas: after loadFromFile() the textures used by animations are
+    // packed by world into a few pages, and the animations point into them.
+    // Packed textures then leave m_textureMap (one copy in VRAM, on the page)
+    struct AtlasRegion {
+        const sf::Texture* page = nullptr;
+        sf::Vector2i offset;
+    };
+    std::map<std::string, sf::Image> m_pendingImages;                    // texture -> pixels, until packed
+    std::unordered_map<std::string, std::string> m_texturePaths;         // texture -> images/ path
+    std::unordered_map<std::string, std::string> m_animationTextures;    // animation -> texture
+    std::unordered_map<std::string, AtlasRegion> m_atlasRegions;         // texture -> where it was packed
+    std::vector<std::unique_ptr<sf::Texture>> m_atlasPages;
+
+    void buildAtlases();
+    void packAtlasPages(std::vector<std::pair<std::string, sf::Vector2u>>& textures);
+
+    bool m_headless = false;                  // no GL: no textures, texture-less animations
+    std::unique_ptr<sf::Texture> m_defaultTexture;   // null when headless
     Animation m_defaultAnimation;
     sf::Font m_defaultFont;
 
 public:
-    Assets();
+    static constexpr unsigned ATLAS_PAGE_SIZE = 4096;   // clamped to the GPU limit
+    static constexpr unsigned ATLAS_PADDING = 2;        // px between packed textures (no bleeding)
+
+    explicit Assets(bool headless = false);
 
     void addTexture(const std::string& name, const std::string& path);
     void addFont(const std::string& name, const std::string& path);
@@ -26,6 +49,7 @@ public:
 
     bool hasAnimation(const std::string& name) const;
 
+    // Not when headless, nor for textures packed into the atlas (use their animations)
     const sf::Texture& getTexture(const std::string& name) const;
     const Animation& getAnimation(const std::string& name) const;
     const sf::Font& getFont(const std::string& name) const;
@@ -33,4 +57,5 @@ public:
     void loadFromFile(const std::string& filePath);
 
     const Animation& getDefaultAnimation() const; 
+    size_t atlasPageCount() const { return m_atlasPages.size(); }
 };
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <tuple>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <type_traits>
+
+// Position of T inside a component tuple (bit index for component masks)
+template <typename T, typename Tuple>
+struct TupleIndex;
+
+template <typename T, typename... Ts>
+struct TupleIndex<T, std::tuple<T, Ts...>> : std::integral_constant<size_t, 0> {};
+
+template <typename T, typename U, typename... Ts>
+struct TupleIndex<T, std::tuple<U, Ts...>>
+    : std::integral_constant<size_t, 1 + TupleIndex<T, std::tuple<Ts...>>::value> {};
+
+// Dense storage for a single component type (sparse set).
+// Slots are entity indices handed out by ComponentStore; components of the same
+// type are packed together so systems can stream through them.
+// Data lives in fixed-size pages: adding a component never moves the existing
+// ones, so references returned by Entity::get<T>() survive spawns made in the
+// same frame. Only release() moves data (swap-and-pop).
+template <typename T>
+class ComponentPool {
+public:
+    static constexpr uint32_t NPOS = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t PAGE_SIZE = 128;
+
+    bool contains(uint32_t slot) const {
+        return slot < m_sparse.size() && m_sparse[slot] != NPOS;
+    }
+
+    template <typename... Args>
+    T& emplace(uint32_t slot, Args&&... args) {
+        if (slot >= m_sparse.size()) {
+            m_sparse.resize(slot + 1, NPOS);
+        }
+        uint32_t& index = m_sparse[slot];
+        if (index == NPOS) {
+            index = static_cast<uint32_t>(m_slots.size());
+            if (index / PAGE_SIZE >= m_pages.size()) {
+                m_pages.push_back(std::make_unique<T[]>(PAGE_SIZE));
+            }
+            m_slots.push_back(slot);
+        }
+        T& component = at(index);
+        component = T(std::forward<Args>(args)...);
+        return component;
+    }
+
+    T& get(uint32_t slot) { return at(m_sparse[slot]); }
+    const T& get(uint32_t slot) const { return at(m_sparse[slot]); }
+
+    // Swap-and-pop removal: the last component takes the freed place.
+    void release(uint32_t slot) {
+        if (!contains(slot)) return;
+
+        uint32_t index = m_sparse[slot];
+        uint32_t last  = static_cast<uint32_t>(m_slots.size() - 1);
+        if (index != last) {
+            at(index) = std::move(at(last));
+            m_slots[index] = m_slots[last];
+            m_sparse[m_slots[index]] = index;
+        }
+        at(last) = T{};
+        m_slots.pop_back();
+        m_sparse[slot] = NPOS;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < m_slots.size(); ++i) {
+            at(i) = T{};
+        }
+        m_slots.clear();
+        m_sparse.clear();
+    }
+
+    // Dense iteration
+    size_t size() const { return m_slots.size(); }
+    const std::vector<uint32_t>& slots() const { return m_slots; }
+    uint32_t slotAt(size_t index) const { return m_slots[index]; }
+    T& valueAt(size_t index) { return at(index); }
+    const T& valueAt(size_t index) const { return at(index); }
+
+private:
+    T& at(size_t index) { return m_pages[index / PAGE_SIZE][index % PAGE_SIZE]; }
+    const T& at(size_t index) const { return m_pages[index / PAGE_SIZE][index % PAGE_SIZE]; }
+
+    std::vector<uint32_t> m_sparse;              // slot -> dense index
+    std::vector<uint32_t> m_slots;               // dense index -> slot
+    std::vector<std::unique_ptr<T[]>> m_pages;   // dense component data
+};
+
+// One pool per component type of the tuple. Slots are entity indices from
+// EntityManager's slot map; releasing a slot drops all of its components.
+template <typename Tuple>
+class ComponentStore;
+
+template <typename... Ts>
+class ComponentStore<std::tuple<Ts...>> {
+public:
+    void release(uint32_t slot) {
+        (std::get<ComponentPool<Ts>>(m_pools).release(slot), ...);
+    }
+
+    void clear() {
+        (std::get<ComponentPool<Ts>>(m_pools).clear(), ...);
+    }
+
+    template <typename T>
+    ComponentPool<T>& pool() { return std::get<ComponentPool<T>>(m_pools); }
+
+    template <typename T>
+    const ComponentPool<T>& pool() const { return std::get<ComponentPool<T>>(m_pools); }
+
+private:
+    std::tuple<ComponentPool<Ts>...> m_pools;
+};
@@ -16,6 +16,7 @@ public:
 class CTransform : public Component {
     public:
         Vec2<float> pos;
+        Vec2<float> prevPos;      // pos at the start of the current fixed step
         Vec2<float> velocity;
         Vec2<float> scale;
         float rotation;
@@ -25,7 +26,7 @@ class CTransform : public Component {
                    const Vec2<float>& v = {0, 0},
                    const Vec2<float>& s = {1, 1},
                    float r = 0.0f)
-            : pos(p), velocity(v), scale(s), rotation(r) {}
+            : pos(p), prevPos(p), velocity(v), scale(s), rotation(r) {}
     
         // Rotate velocity vector by a given angle in degrees
         void rotate(float angleDegrees) {
@@ -154,6 +155,16 @@ class CTileTouched : public Component {
             : inFront(inFront_) {}
 };
 
+// Set at level load on tiles that keep their own colours at any time of day
+// (treasure boxes, the future armor pickup)
+class CLighting : public Component {
+    public:
+        bool unlit;
+
+        explicit CLighting(bool unlit_ = false)
+            : unlit(unlit_) {}
+};
+
 class CStopAfterTime : public Component {
     public:
         float timer = -1.f;  // Default is negative, meaning "inactive"
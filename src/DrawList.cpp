@@ -0,0 +1,121 @@
+#include "DrawList.h"
+
+DrawList::DrawList(sf::RenderTarget& target)
+    : m_target(&target)
+{
+}
+
+void DrawList::begin(sf::Vector2u size, const sf::View& defaultView) {
+    m_commands.clear();
+    m_vertices.clear();
+    m_views.clear();
+    m_sprites.clear();
+    m_texts.clear();
+    m_shapes.clear();
+    m_size = size;
+    m_defaultView = defaultView;
+    m_view = defaultView;
+}
+
+DrawList::Command& DrawList::push(CommandType type, size_t index, const sf::RenderStates& states) {
+    Command& command = m_commands.emplace_back();
+    command.type = type;
+    command.index = index;
+    command.states = states;
+    return command;
+}
+
+void DrawList::replay(sf::RenderTarget& target) const {
+    for (const Command& command : m_commands) {
+        switch (command.type) {
+            case CommandType::Clear:
+                target.clear(command.color);
+                break;
+            case CommandType::SetView:
+                target.setView(m_views[command.index]);
+                break;
+            case CommandType::Vertices:
+                target.draw(&m_vertices[command.index], command.count, command.primitive, command.states);
+                break;
+            case CommandType::Sprite:
+                target.draw(m_sprites[command.index], command.states);
+                break;
+            case CommandType::Text:
+                target.draw(m_texts[command.index], command.states);
+                break;
+            case CommandType::Shape:
+                target.draw(m_shapes[command.index], command.states);
+                break;
+        }
+    }
+}
+
+void DrawList::clear(const sf::Color& color) {
+    if (m_target) {
+        m_target->clear(color);
+        return;
+    }
+    push(CommandType::Clear, 0).color = color;
+}
+
+void DrawList::setView(const sf::View& view) {
+    if (m_target) {
+        m_target->setView(view);
+        return;
+    }
+    m_view = view;
+    push(CommandType::SetView, m_views.size());
+    m_views.push_back(view);
+}
+
+const sf::View& DrawList::getView() const {
+    return m_target ? m_target->getView() : m_view;
+}
+
+const sf::View& DrawList::getDefaultView() const {
+    return m_target ? m_target->getDefaultView() : m_defaultView;
+}
+
+sf::Vector2u DrawList::getSize() const {
+    return m_target ? m_target->getSize() : m_size;
+}
+
+void DrawList::draw(const sf::Sprite& sprite, const sf::RenderStates& states) {
+    if (m_target) {
+        m_target->draw(sprite, states);
+        return;
+    }
+    push(CommandType::Sprite, m_sprites.size(), states);
+    m_sprites.push_back(sprite);
+}
+
+void DrawList::draw(const sf::Text& text, const sf::RenderStates& states) {
+    if (m_target) {
+        m_target->draw(text, states);
+        return;
+    }
+    push(CommandType::Text, m_texts.size(), states);
+    m_texts.push_back(text);
+}
+
+void DrawList::draw(const sf::RectangleShape& shape, const sf::RenderStates& states) {
+    if (m_target) {
+        m_target->draw(shape, states);
+        return;
+    }
+    push(CommandType::Shape, m_shapes.size(), states);
+    m_shapes.push_back(shape);
+}
+
+void DrawList::draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type,
+                    const sf::RenderStates& states) {
+    if (m_target) {
+        m_target->draw(vertices, count, type, states);
+        return;
+    }
+    if (count == 0) return;
+    Command& command = push(CommandType::Vertices, m_vertices.size(), states);
+    command.count = count;
+    command.primitive = type;
+    m_vertices.insert(m_vertices.end(), vertices, vertices + count);
+}
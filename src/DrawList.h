@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// What the play renderer draws through: the subset of sf::RenderTarget it
+// uses. Bound to a target (DrawList(window)) every call goes straight through.
+// Unbound, the calls are recorded into an immutable snapshot of the frame
+// (copies of the vertices, sprites, texts and shapes, plus view changes) that
+// the render thread replays onto the window while the next frame simulates.
+//
+// A recorded frame only keeps pointers to textures and fonts: they must stay
+// alive and unchanged until it is replayed (see RenderThread).
+class DrawList {
+public:
+    DrawList() = default;
+    explicit DrawList(sf::RenderTarget& target);
+
+    // Empties a recording list for a target of this size / default view
+    void begin(sf::Vector2u size, const sf::View& defaultView);
+    void replay(sf::RenderTarget& target) const;
+    size_t commandCount() const { return m_commands.size(); }
+
+    void clear(const sf::Color& color = sf::Color::Black);
+    void setView(const sf::View& view);
+    const sf::View& getView() const;
+    const sf::View& getDefaultView() const;
+    sf::Vector2u getSize() const;
+
+    void draw(const sf::Sprite& sprite, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Text& text, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::RectangleShape& shape, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type,
+              const sf::RenderStates& states = sf::RenderStates::Default);
+
+private:
+    enum class CommandType {
+        Clear,
+        SetView,
+        Vertices,
+        Sprite,
+        Text,
+        Shape
+    };
+
+    struct Command {
+        CommandType type = CommandType::Clear;
+        size_t index = 0;           // in the vector of its type (m_vertices: first vertex)
+        size_t count = 0;           // Vertices only
+        sf::PrimitiveType primitive = sf::Triangles;
+        sf::Color color;            // Clear only
+        sf::RenderStates states;
+    };
+
+    Command& push(CommandType type, size_t index, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    sf::RenderTarget* m_target = nullptr;   // null: recording
+
+    std::vector<Command> m_commands;
+    std::vector<sf::Vertex> m_vertices;
+    std::vector<sf::View> m_views;
+    std::vector<sf::Sprite> m_sprites;
+    std::vector<sf::Text> m_texts;
+    std::vector<sf::RectangleShape> m_shapes;
+
+    sf::Vector2u m_size;
+    sf::View m_defaultView;
+    sf::View m_view;                        // current view while recording
+};
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <tuple>
+#include <vector>
 #include <string>
 #include <utility>
 #include <SFML/Graphics.hpp>
 #include "Components.hpp"
+#include "ComponentPool.hpp"
+#include "EntityTags.hpp"
 
 // Componenti inclusi nel tuple, ora con CEnemyAI aggiornato
 using ComponentTuple = std::tuple<
@@ -22,64 +25,159 @@ using ComponentTuple = std::tuple<
     CUniqueID,
     CPlayerEquipment,
     CTileTouched,
+    CLighting,
     CAmmo,
     CStopAfterTime,
     CBossPhase
     >;
 
+// I componenti vivono negli array densi dell'EntityManager, non nell'entità
+using EntityComponentStore = ComponentStore<ComponentTuple>;
+
+// One bit per ComponentTuple entry, set while the entity owns that component
+using ComponentMask = uint32_t;
+static_assert(std::tuple_size_v<ComponentTuple> <= 32, "ComponentMask too small for ComponentTuple");
+
+class Entity;
+
+// What an EntityManager shares with its entities. Heap-allocated by the
+// manager, so moving the manager doesn't leave entities pointing at it.
+struct EntityContext {
+    EntityComponentStore components;
+    std::vector<Entity*> pendingDestroy;   // destroyed since the last update()
+};
+
+// 32-bit entity handle: slot index in the low bits, slot generation in the
+// high bits. The generation is bumped every time a slot is freed, so a handle
+// kept after its entity was removed no longer resolves (EntityManager::get).
+struct EntityHandle {
+    static constexpr uint32_t INDEX_BITS      = 20;
+    static constexpr uint32_t INDEX_MASK      = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+    static constexpr uint32_t INVALID         = 0xFFFFFFFFu;
+
+    uint32_t value = INVALID;
+
+    EntityHandle() = default;
+    EntityHandle(uint32_t index, uint32_t generation)
+        : value(((generation & GENERATION_MASK) << INDEX_BITS) | (index & INDEX_MASK)) {}
+
+    uint32_t index() const { return value & INDEX_MASK; }
+    uint32_t generation() const { return value >> INDEX_BITS; }
+    bool isValid() const { return value != INVALID; }
+
+    bool operator==(const EntityHandle& other) const { return value == other.value; }
+    bool operator!=(const EntityHandle& other) const { return value != other.value; }
+};
+
+// Entities live in EntityManager's slot map and are recycled in place:
+// an Entity* is only valid until the next EntityManager::update().
+// Keep an EntityHandle for anything that must outlive the frame.
 class Entity {
 private:
-    ComponentTuple m_components;
-    bool m_alive = true;
-    std::string m_tag;
-    size_t m_id;
+    EntityContext* m_context;
+    EntityHandle m_handle;
+    uint32_t m_entityIndex = 0;   // back-index into EntityManager::m_entities
+    uint32_t m_groupIndex  = 0;   // back-index into its tag group
+    ComponentMask m_mask = 0;
+    bool m_alive = false;
+    bool m_active = false;   // published by EntityManager::update()
+    TagId m_tag = TagId::Count;
+    size_t m_id = 0;
+
+    friend class EntityManager;
+    friend class EntityView;
+
+    void spawn(TagId tag, size_t id, uint32_t generation) {
+        m_handle = EntityHandle(m_handle.index(), generation);
+        m_tag    = tag;
+        m_id     = id;
+        m_mask   = 0;
+        m_alive  = true;
+        m_active = false;
+    }
 
 public:
-    // Costruttore
-    Entity(const std::string& tag, size_t id)
-        : m_components(), m_tag(tag), m_id(id) {}
+    // Costruttore (solo EntityManager crea gli slot)
+    Entity(EntityContext* context, uint32_t index)
+        : m_context(context), m_handle(index, 0) {}
+
+    Entity(const Entity&) = delete;
+    Entity& operator=(const Entity&) = delete;
 
     // Stato dell'entità
     bool isAlive() const { return m_alive; }
-    void destroy() { m_alive = false; }
+    void destroy() {
+        if (!m_alive) return;
+        m_alive = false;
+        m_context->pendingDestroy.push_back(this);
+    }
 
     // Metadati
-    const std::string& tag() const { return m_tag; }
+    TagId tag() const { return m_tag; }
     size_t id() const { return m_id; }
+    EntityHandle handle() const { return m_handle; }
 
     // Gestione dei Componenti
     template <typename T, typename... Args>
     void add(Args&&... args) {
         static_assert(tuple_has_type<T, ComponentTuple>::value, "Component not found in tuple!");
-        std::get<T>(m_components) = T(std::forward<Args>(args)...);
+        m_context->components.pool<T>().emplace(m_handle.index(), std::forward<Args>(args)...);
+        m_mask |= maskOf<T>();
     }
     template <typename T>
     void remove() {
         static_assert(tuple_has_type<T, ComponentTuple>::value, "Component not found in tuple!");
-        std::get<T>(m_components) = T{};  // Reassign component to a default-constructed state
+        // Swap-and-pop in the pool: don't keep references to other entities' T across this call
+        m_context->components.pool<T>().release(m_handle.index());
+        m_mask &= ~maskOf<T>();
     }
 
+    // A missing component is created default-constructed, as the old tuple
+    // always had one: writes through get<T>() must persist. It is not owned,
+    // though: the mask bit is only set by add<T>(), so has<T>() and views
+    // keep ignoring it.
     template <typename T>
     T& get() {
         static_assert(tuple_has_type<T, ComponentTuple>::value, "Component not found in tuple!");
-        return std::get<T>(m_components);
+        auto& pool = m_context->components.pool<T>();
+        if (!pool.contains(m_handle.index())) {
+            return pool.emplace(m_handle.index());
+        }
+        return pool.get(m_handle.index());
     }
 
     template <typename T>
     const T& get() const {
         static_assert(tuple_has_type<T, ComponentTuple>::value, "Component not found in tuple!");
-        return std::get<T>(m_components);
+        static const T defaultComponent{};
+        const auto& pool = m_context->components.pool<T>();
+        if (!pool.contains(m_handle.index())) {
+            return defaultComponent;
+        }
+        return pool.get(m_handle.index());
     }
 
-    // Verifica se un componente è presente (a compile-time, restituisce true per i tipi del tuple)
+    // Verifica se un componente è presente (bit impostato solo da add<T>())
     template <typename T>
     bool has() const {
-        return tuple_has_type<T, ComponentTuple>::value;
+        if constexpr (tuple_has_type<T, ComponentTuple>::value) {
+            return (m_mask & maskOf<T>()) != 0;
+        }
+        return false;
     }
 
+    template <typename... Ts>
+    static constexpr ComponentMask maskOf() {
+        return (ComponentMask(0) | ... | (ComponentMask(1) << TupleIndex<Ts, ComponentTuple>::value));
+    }
+
+    ComponentMask mask() const { return m_mask; }
+    bool hasAll(ComponentMask mask) const { return (m_mask & mask) == mask; }
+
     // Bounding Box
     sf::FloatRect getBounds() const {
-        if constexpr (tuple_has_type<CBoundingBox, ComponentTuple>::value) {
+        if (has<CBoundingBox>()) {
             const auto& transform = get<CTransform>();
             const auto& bbox = get<CBoundingBox>();
             return bbox.getRect(transform.pos);
@@ -2,71 +2,218 @@
 
 #include "Entity.hpp"
 #include <vector>
-#include <map>
+#include <deque>
+#include <array>
+#include <span>
 #include <memory>
 #include <string>
+#include <iostream>
 #include <algorithm>
+#include <cstdlib>
 
-using EntityVec = std::vector<std::shared_ptr<Entity>>;
-using EntityMap = std::map<std::string, EntityVec>;
+using EntityVec = std::vector<Entity*>;
+using EntityMap = std::array<EntityVec, TAG_COUNT>;
+
+// Non-owning view of an entity group: copying it copies two words, not the
+// group. Groups only change inside EntityManager::update() (spawns wait in
+// m_toAdd), so a span stays valid until the next update.
+using EntitySpan = std::span<Entity* const>;
+
+// Live entities whose component mask contains `mask`, walked along one pool's
+// slot list (the smallest of the requested types). Yields Entity&.
+class EntityView {
+public:
+    class iterator {
+    public:
+        iterator(const std::deque<Entity>* entities, const std::vector<uint32_t>* slots,
+                 size_t index, ComponentMask mask)
+            : m_entities(entities), m_slots(slots), m_index(index), m_mask(mask) { skip(); }
+
+        Entity& operator*() const { return const_cast<Entity&>((*m_entities)[(*m_slots)[m_index]]); }
+        iterator& operator++() { ++m_index; skip(); return *this; }
+        // The pool may grow while we iterate: compare against its live size
+        bool operator!=(const iterator&) const { return m_index < m_slots->size(); }
+
+    private:
+        void skip() {
+            while (m_index < m_slots->size()) {
+                const Entity& entity = (*m_entities)[(*m_slots)[m_index]];
+                if (entity.m_active && entity.isAlive() && entity.hasAll(m_mask)) break;
+                ++m_index;
+            }
+        }
+
+        const std::deque<Entity>* m_entities;
+        const std::vector<uint32_t>* m_slots;
+        size_t m_index;
+        ComponentMask m_mask;
+    };
+
+    EntityView(const std::deque<Entity>* entities, const std::vector<uint32_t>* slots, ComponentMask mask)
+        : m_entities(entities), m_slots(slots), m_mask(mask) {}
+
+    iterator begin() const { return iterator(m_entities, m_slots, 0, m_mask); }
+    iterator end() const { return iterator(m_entities, m_slots, m_slots->size(), m_mask); }
+
+private:
+    const std::deque<Entity>* m_entities;
+    const std::vector<uint32_t>* m_slots;
+    ComponentMask m_mask;
+};
 
 class EntityManager {
+    // Freed slots wait in a FIFO until this many have piled up, so the same
+    // slot (and generation counter) isn't recycled by every single bullet.
+    static constexpr size_t MIN_FREE_SLOTS = 1024;
+
+    std::deque<Entity> m_slots;         // Slot map: entities are recycled in place (stable addresses)
+    std::deque<uint32_t> m_freeSlots;   // Released slot indices, oldest first
     EntityVec m_entities;    // Stores all entities
     EntityVec m_toAdd;       // Temporary storage for entities to be added
-    EntityMap m_entityMap;   // Maps tags to groups of entities
+    EntityMap m_entityMap;   // One group of entities per TagId
+    std::array<uint64_t, TAG_COUNT> m_groupVersions{}; // Bumped whenever an entity joins or leaves a group
     size_t m_totalEntities = 0; // Counter for unique entity IDs
+    std::unique_ptr<EntityContext> m_context; // Component pools + pending destroys (heap: entities keep a pointer)
+
+    // Slot indices stop below INDEX_MASK: index INDEX_MASK with the last
+    // generation would encode as EntityHandle::INVALID
+    static constexpr size_t MAX_SLOTS = EntityHandle::INDEX_MASK;
+
+    uint32_t acquireSlot() {
+        if (m_freeSlots.size() > MIN_FREE_SLOTS ||
+            (!m_freeSlots.empty() && m_slots.size() >= MAX_SLOTS)) {
+            uint32_t index = m_freeSlots.front();
+            m_freeSlots.pop_front();
+            return index;
+        }
+        if (m_slots.size() >= MAX_SLOTS) {
+            // A wider index won't fit in the handle: it would alias a live entity
+            std::cerr << "[ERROR] EntityManager: out of entity slots (" << m_slots.size() << " live entities)\n";
+            std::abort();
+        }
+        uint32_t index = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back(m_context.get(), index);
+        return index;
+    }
+
+    // O(1) removal from a group: the last entity takes the freed place
+    static void unlink(EntityVec& vec, uint32_t index, uint32_t Entity::* backIndex) {
+        Entity* last = vec.back();
+        vec[index] = last;
+        last->*backIndex = index;
+        vec.pop_back();
+    }
+
+    void releaseSlot(Entity& entity) {
+        uint32_t index = entity.m_handle.index();
+        m_context->components.release(index);
+        entity.m_handle = EntityHandle(index, entity.m_handle.generation() + 1);
+        entity.m_mask   = 0;
+        entity.m_active = false;
+        m_freeSlots.push_back(index);
+    }
 
 public:
+    EntityManager() : m_context(std::make_unique<EntityContext>()) {}
+
+    EntityManager(const EntityManager&) = delete;
+    EntityManager& operator=(const EntityManager&) = delete;
+    EntityManager(EntityManager&&) = default;
+    EntityManager& operator=(EntityManager&&) = default;
+
     // Add a new entity with a given tag
-    std::shared_ptr<Entity> addEntity(const std::string& tag) {
-        auto entity = std::shared_ptr<Entity>(new Entity(tag, m_totalEntities++));
-        m_toAdd.push_back(entity);
-        return entity;
+    Entity* addEntity(TagId tag) {
+        uint32_t index = acquireSlot();
+        Entity& entity = m_slots[index];
+        entity.spawn(tag, m_totalEntities++, entity.m_handle.generation());
+        m_toAdd.push_back(&entity);
+        return &entity;
     }
+
+    // Resolve a handle; nullptr once the entity is dead or its slot was reused
+    Entity* get(EntityHandle handle) {
+        if (!handle.isValid() || handle.index() >= m_slots.size()) return nullptr;
+        Entity& entity = m_slots[handle.index()];
+        if (entity.m_handle != handle || !entity.isAlive()) return nullptr;
+        return &entity;
+    }
+
+    bool isAlive(EntityHandle handle) const {
+        if (!handle.isValid() || handle.index() >= m_slots.size()) return false;
+        const Entity& entity = m_slots[handle.index()];
+        return entity.m_handle == handle && entity.isAlive();
+    }
+
     // Update the EntityManager
     void update() {
         // Move new entities from m_toAdd to main storage
+        // (one destroyed before it was ever published is just released below)
         for (auto& entity : m_toAdd) {
+            if (!entity->isAlive()) continue;
+            auto& group = m_entityMap[static_cast<size_t>(entity->tag())];
+            entity->m_active      = true;
+            entity->m_entityIndex = static_cast<uint32_t>(m_entities.size());
+            entity->m_groupIndex  = static_cast<uint32_t>(group.size());
             m_entities.push_back(entity);
-            m_entityMap[entity->tag()].push_back(entity);
+            group.push_back(entity);
+            ++m_groupVersions[static_cast<size_t>(entity->tag())];
         }
         m_toAdd.clear();
 
-        // Remove dead entities from m_entities
-        m_entities.erase(
-            std::remove_if(m_entities.begin(), m_entities.end(),
-                           [](const auto& e) { return !e->isAlive(); }),
-            m_entities.end()
-        );
-
-        // Remove dead entities from m_entityMap
-        for (auto& [tag, vec] : m_entityMap) {
-            vec.erase(
-                std::remove_if(vec.begin(), vec.end(),
-                               [](const auto& e) { return !e->isAlive(); }),
-                vec.end()
-            );
+        // Only entities destroyed since the last update are touched here
+        auto& pending = m_context->pendingDestroy;
+        for (Entity* entity : pending) {
+            if (entity->m_active) {
+                unlink(m_entities, entity->m_entityIndex, &Entity::m_entityIndex);
+                unlink(m_entityMap[static_cast<size_t>(entity->tag())], entity->m_groupIndex, &Entity::m_groupIndex);
+                ++m_groupVersions[static_cast<size_t>(entity->tag())];
+            }
+            releaseSlot(*entity);
         }
+        pending.clear();
     }
 
     // Retrieve all entities
-    EntityVec& getEntities() { return m_entities; }
+    EntitySpan getEntities() const { return m_entities; }
 
     // Retrieve entities by tag
-    EntityVec& getEntities(const std::string& tag) { return m_entityMap[tag]; }
+    EntitySpan getEntities(TagId tag) const { return m_entityMap[static_cast<size_t>(tag)]; }
+    // Changes with every entity added to or removed from the group (never goes back)
+    uint64_t groupVersion(TagId tag) const { return m_groupVersions[static_cast<size_t>(tag)]; }
 
-    size_t countEntities(const std::string& tag) const {
-        auto it = m_entityMap.find(tag);
-        if (it != m_entityMap.end()) {
-            return it->second.size();
+    // Stream through every live entity that owns a T, in pool order
+    // (skipping components a stray get<T>() created but nobody add<T>()ed)
+    template <typename T, typename Func>
+    void each(Func&& func) {
+        auto& pool = m_context->components.pool<T>();
+        for (size_t i = 0; i < pool.size(); ++i) {
+            Entity& entity = m_slots[pool.slotAt(i)];
+            if (!entity.m_active || !entity.isAlive() || !entity.has<T>()) continue;
+            func(entity, pool.valueAt(i));
         }
-        return 0;
     }
+
+    // Entities owning all of Ts (e.g. view<CTransform, CBoundingBox>())
+    template <typename... Ts>
+    EntityView view() const {
+        static_assert(sizeof...(Ts) > 0, "view<>() needs at least one component type");
+        const std::vector<uint32_t>* slots = nullptr;
+        ((slots = (!slots || m_context->components.pool<Ts>().size() < slots->size())
+                      ? &m_context->components.pool<Ts>().slots() : slots), ...);
+        return EntityView(&m_slots, slots, Entity::maskOf<Ts...>());
+    }
+
+    size_t countEntities(TagId tag) const { return getEntities(tag).size(); }
         // **New Method: Clear All Entities**
     void clear() {
+        m_context->components.clear();
+        m_context->pendingDestroy.clear();
+        m_slots.clear();
+        m_freeSlots.clear();
         m_entities.clear();
         m_toAdd.clear();
-        m_entityMap.clear();
+        for (auto& vec : m_entityMap) vec.clear();
+        for (auto& version : m_groupVersions) ++version;
         m_totalEntities = 0;
     }
 };
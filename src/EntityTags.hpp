@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Entity groups. EntityManager keeps one vector per TagId in a plain array,
+// so looking a group up is an index, never a string compare.
+enum class TagId : uint8_t {
+    Player,
+    Tile,
+    Decoration,
+    Enemy,
+    SuperEnemy,
+    Sword,
+    PlayerBullet,
+    EnemySword,
+    EnemyBullet,
+    EnemyGrave,
+    EmperorSword,
+    EmperorSwordArmor,
+    EmperorSwordRadial,
+    EmperorBlackHole,
+    EmperorMassiveBlackHole,
+    Fragment,
+    Collectable,
+    Effect,
+    Count
+};
+
+static constexpr size_t TAG_COUNT = static_cast<size_t>(TagId::Count);
+
+inline const char* tagName(TagId tag) {
+    switch (tag) {
+        case TagId::Player:                  return "player";
+        case TagId::Tile:                    return "tile";
+        case TagId::Decoration:              return "decoration";
+        case TagId::Enemy:                   return "enemy";
+        case TagId::SuperEnemy:              return "superEnemy";
+        case TagId::Sword:                   return "sword";
+        case TagId::PlayerBullet:            return "playerBullet";
+        case TagId::EnemySword:              return "enemySword";
+        case TagId::EnemyBullet:             return "enemyBullet";
+        case TagId::EnemyGrave:              return "enemyGrave";
+        case TagId::EmperorSword:            return "EmperorSword";
+        case TagId::EmperorSwordArmor:       return "EmperorSwordArmor";
+        case TagId::EmperorSwordRadial:      return "EmperorSwordRadial";
+        case TagId::EmperorBlackHole:        return "emperorBlackHole";
+        case TagId::EmperorMassiveBlackHole: return "emperorMassiveBlackHole";
+        case TagId::Fragment:                return "fragment";
+        case TagId::Collectable:             return "collectable";
+        case TagId::Effect:                  return "effect";
+        default:                             return "unknown";
+    }
+}
@@ -9,37 +9,46 @@
 #include <filesystem> 
 #include <ctime> 
 
-GameEngine::GameEngine(const std::string& path) {
+GameEngine::GameEngine(const std::string& path, bool headless)
+    : m_headless(headless),
+      m_assets(headless)
+{
     // Reference resolution (fixed, designed resolution)ß
     m_referenceResolution = sf::Vector2f(1920.0f, 1080.0f);
 
-    // Get desktop resolution
-    sf::VideoMode desktopMode = sf::VideoMode::getDesktopMode();
+    if (!m_headless) {
+        // Get desktop resolution
+        sf::VideoMode desktopMode = sf::VideoMode::getDesktopMode();
 
-    // Window uses desktop resolution, capped to your reference resolution if smaller
-    int windowWidth = std::min(desktopMode.width, static_cast<unsigned>(m_referenceResolution.x));
-    int windowHeight = std::min(desktopMode.height, static_cast<unsigned>(m_referenceResolution.y));
+        // Window uses desktop resolution, capped to your reference resolution if smaller
+        int windowWidth = std::min(desktopMode.width, static_cast<unsigned>(m_referenceResolution.x));
+        int windowHeight = std::min(desktopMode.height, static_cast<unsigned>(m_referenceResolution.y));
 
-    m_window.create(sf::VideoMode(windowWidth, windowHeight), "Game Window");
+        m_window = std::make_unique<sf::RenderWindow>(sf::VideoMode(windowWidth, windowHeight), "Game Window");
+        m_windowFrame = DrawList(*m_window);
 
-    // Set view explicitly to the reference resolution (no scaling calculation needed!)
-    m_cameraView = sf::View(sf::FloatRect(0.f, 0.f, m_referenceResolution.x, m_referenceResolution.y));
-    m_window.setView(m_cameraView);
+        // Set view explicitly to the reference resolution (no scaling calculation needed!)
+        m_cameraView = sf::View(sf::FloatRect(0.f, 0.f, m_referenceResolution.x, m_referenceResolution.y));
+        m_window->setView(m_cameraView);
 
-    m_window.setFramerateLimit(100);
+        // Simulation runs in fixed steps, so drawing can follow the display
+        m_window->setVerticalSyncEnabled(true);
+    }
+
+    m_headlessSize = sf::Vector2u(static_cast<unsigned>(m_referenceResolution.x), static_cast<unsigned>(m_referenceResolution.y));
 
-    // Seed random number generator
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
+    // Seed random number generator (once per session; recordings reseed it)
+    m_random.reseed(static_cast<uint32_t>(std::time(nullptr)));
 
-    universeNumber = rand() % 900 + 100;
-    alternateUniverseNumber = rand() % 900 + 100;
-    alternateUniverseNumber2 = rand() % 900 + 100;
+    universeNumber = m_random.below(900) + 100;
+    alternateUniverseNumber = m_random.below(900) + 100;
+    alternateUniverseNumber2 = m_random.below(900) + 100;
 
     // Load assets globally
     m_assets.loadFromFile(path);
 
     //  Set the default camera view
-    m_cameraView = m_window.getDefaultView();
+    m_cameraView = defaultView();
 
     //  Define level transitions
     m_levelConnections = {
@@ -60,8 +69,10 @@ GameEngine::GameEngine(const std::string& path) {
     m_scenes["INTRO"] = nullptr;  // Will be properly created when needed
     m_scenes["ENDING"] = nullptr;  // Will be properly created when needed
 
-    // Start in menu
-    changeScene("MENU", std::make_shared<Scene_Menu>(*this));
+    // Start in menu (headless: the caller loads a level)
+    if (!m_headless) {
+        changeScene("MENU", std::make_shared<Scene_Menu>(*this));
+    }
 }
 
 //  Retrieve the current scene
@@ -101,7 +112,8 @@ const std::string& GameEngine::getCurrentLevel() const {
 
 //  Load a new level and update the current level
 void GameEngine::loadLevel(const std::string& levelPath) {
-    
+    TRACE_ZONE("GameEngine::loadLevel");
+
     if (levelPath.empty()) {
         //std::cerr << "[ERROR] Attempted to load an empty level path!\n";
         return;
@@ -114,6 +126,18 @@ void GameEngine::loadLevel(const std::string& levelPath) {
     }
     
     m_currentLevel = levelPath;  //  Ensure current level is stored
+
+    // An armed recording starts here, before the scene draws any random number
+    if (!m_recordPath.empty() && !m_recording) {
+        m_recording = std::make_unique<InputRecording>();
+        m_recording->seed = m_random.next();
+        m_recording->level = levelPath.substr(levelPath.find_last_of("/\\") + 1);
+        m_recording->language = m_language;
+        m_recording->windowSize = windowSize();
+        m_random.reseed(m_recording->seed);
+        m_stepCount = 0;
+    }
+
     //std::cout << "[DEBUG] Loading Level: " << m_currentLevel << std::endl;
 
     // Set the world type based on the level name
@@ -131,7 +155,7 @@ void GameEngine::loadLevel(const std::string& levelPath) {
 
 // Check if the game is running
 bool GameEngine::isRunning() const {
-    return m_running && m_window.isOpen();
+    return m_running && (m_headless || m_window->isOpen());
 }
 
 // Run the game loop
@@ -141,41 +165,238 @@ void GameEngine::run() {
     }
 }
 
-// Update the current scene
+// One frame: input -> update -> render/display -> scene transitions
+// (with the render thread on, input is polled at the end of the previous frame)
 void GameEngine::update() {
-    sUserInput();
+    TRACE_ZONE("frame");
+
+    if (m_renderThread.running()) {
+        TRACE_ZONE("waitForRenderThread");
+        m_renderThread.waitForPickup();
+        m_resourceLock.lock();
+    } else {
+        TRACE_ZONE("sUserInput");
+        sUserInput();
+    }
 
     if (m_currentScene) {
-        float deltaTime = getDeltaTime();
+        applyActions();
 
-        while (hasActions()) {
-            Action action = popAction();
-            m_currentScene->sDoAction(action);
+        if (m_currentScene->usesImGui()) {
+            // ImGui wants exactly one update per drawn frame
+            m_currentScene->update(getDeltaTime());
+            m_interpolation = 1.f;
+        } else {
+            m_accumulator += getDeltaTime();
+            // Kept alive until the steps are done, even if it changes scene
+            std::shared_ptr<Scene> scene = m_currentScene;
+            int steps = 0;
+            while (m_accumulator >= FIXED_STEP && steps < MAX_STEPS_PER_FRAME) {
+                simulateStep(*scene);
+                ++steps;
+                if (m_currentScene != scene) break;   // the new scene starts next frame
+                m_accumulator -= FIXED_STEP;
+                // Transitions happen right after the step that asked for them
+                // (as in step(), so replays take them at the same step)
+                if (!m_pendingLevelChange.empty() || m_showEndingScreen) break;
+            }
+            if (m_accumulator >= FIXED_STEP) {
+                // std::cout << "[DEBUG] Dropping " << m_accumulator << "s of simulation\n";
+                m_accumulator = 0.f;
+            }
+            m_interpolation = m_accumulator / FIXED_STEP;
         }
 
-        m_currentScene->update(deltaTime);
-        m_currentScene->sRender();
+        // The scene current after update() (it may have switched) is drawn once
+        {
+            TRACE_ZONE("GameEngine::render");
+            render();
+        }
+        PROFILE_END_FRAME(m_profiler);
 
-        //  Process pending level change AFTER update cycle
-        if (!m_pendingLevelChange.empty()) {
-            std::string nextLevel = m_pendingLevelChange;
-            m_pendingLevelChange = "";
-            loadLevel(nextLevel);
+        processTransitions();
+    }
+
+    if (m_resourceLock.owns_lock()) m_resourceLock.unlock();
+}
+
+// One fixed step, no input, clock or drawing: headless runs go as fast as
+// the simulation does and step the same way whatever the machine
+void GameEngine::step() {
+    if (!m_currentScene) return;
+
+    // Replaying: the actions that were applied before this step
+    if (m_replay) {
+        const auto& actions = m_replay->actions;
+        while (m_replayAction < actions.size() && actions[m_replayAction].step <= m_stepCount) {
+            pushAction(actions[m_replayAction].action);
+            ++m_replayAction;
         }
-        
-        // Check if we need to show the ending when the final level is completed
-        if (m_showEndingScreen) {
-            m_showEndingScreen = false;
-            worldType = "Normal"; // Reset to Normal world type
-            changeScene("ENDING", std::make_shared<Scene_StoryText>(*this, StoryType::ENDING));
+    }
+    applyActions();
+
+    std::shared_ptr<Scene> scene = m_currentScene;
+    simulateStep(*scene);
+    PROFILE_END_FRAME(m_profiler);
+
+    processTransitions();
+}
+
+// Queued actions go to the current scene (and into the recording)
+void GameEngine::applyActions() {
+    while (hasActions()) {
+        Action action = popAction();
+        if (m_recording) {
+            m_recording->actions.push_back({m_stepCount, action});
+        }
+        m_currentScene->sDoAction(action);
+    }
+}
+
+// One fixed step of `scene`, checksummed every CHECKSUM_INTERVAL steps
+// while recording or replaying
+void GameEngine::simulateStep(Scene& scene) {
+    TRACE_ZONE("step");
+    scene.update(FIXED_STEP);
+    ++m_stepCount;
+
+    if (m_stepCount % InputRecording::CHECKSUM_INTERVAL != 0) return;
+
+    if (m_recording) {
+        m_recording->checksums.push_back({m_stepCount, scene.stateHash()});
+    }
+    if (m_replay) {
+        const auto& checksums = m_replay->checksums;
+        while (m_replayChecksum < checksums.size() && checksums[m_replayChecksum].step < m_stepCount) {
+            ++m_replayChecksum;
         }
+        if (m_replayChecksum < checksums.size() && checksums[m_replayChecksum].step == m_stepCount) {
+            if (checksums[m_replayChecksum].hash == scene.stateHash()) {
+                ++m_replayMatched;
+            } else if (m_replayDivergedAt == 0) {
+                m_replayDivergedAt = m_stepCount;
+                std::cerr << "[WARNING] Replay diverged from the recording at step " << m_stepCount << std::endl;
+            }
+            ++m_replayChecksum;
+        }
+    }
+}
+
+void GameEngine::finishRecording() {
+    if (!m_recording) return;
+
+    m_recording->steps = m_stepCount;
+    if (m_recording->save(m_recordPath)) {
+        std::cout << "[INFO] Recorded " << m_stepCount << " steps to " << m_recordPath << std::endl;
     }
+    m_recording.reset();
+    m_recordPath.clear();   // one session per run
+}
+
+bool GameEngine::startReplay(const std::string& path) {
+    if (!m_headless) {
+        std::cerr << "[ERROR] Recordings are replayed headless only\n";
+        return false;
+    }
+
+    auto replay = std::make_unique<InputRecording>();
+    if (!replay->load(path)) return false;
+
+    std::string levelPath = getResourcePath("levels") + "/" + replay->level;
+    if (!std::filesystem::exists(levelPath)) {
+        std::cerr << "[ERROR] Recorded level does not exist: " << levelPath << std::endl;
+        return false;
+    }
+
+    // Everything the recorded session started from
+    if (replay->windowSize.x != 0 && replay->windowSize.y != 0) {
+        m_headlessSize = replay->windowSize;
+    }
+    setLanguage(replay->language);
+    m_random.reseed(replay->seed);
+
+    m_replay = std::move(replay);
+    m_replayAction = 0;
+    m_replayChecksum = 0;
+    m_replayMatched = 0;
+    m_replayDivergedAt = 0;
+
+    loadLevel(levelPath);
+    m_stepCount = 0;
+    return m_currentScene != nullptr;
+}
+
+// Scene changes requested during the update, done once it is over
+void GameEngine::processTransitions() {
+    //  Process pending level change AFTER update cycle
+    if (!m_pendingLevelChange.empty()) {
+        std::string nextLevel = m_pendingLevelChange;
+        m_pendingLevelChange = "";
+        loadLevel(nextLevel);
+    }
+    
+    // Check if we need to show the ending when the final level is completed
+    if (m_showEndingScreen) {
+        m_showEndingScreen = false;
+        worldType = "Normal"; // Reset to Normal world type
+        if (m_headless) {
+            stop();   // the story screens need a window
+            return;
+        }
+        changeScene("ENDING", std::make_shared<Scene_StoryText>(*this, StoryType::ENDING));
+    }
+}
+
+// Scenes only draw: clearing is theirs, presenting is done here
+// (or by the render thread, for the scenes that draw to frame())
+void GameEngine::render() {
+    ++m_frameCount;
+
+    if (m_renderThreaded && m_currentScene->drawsToFrame()) {
+        if (!m_renderThread.running()) m_renderThread.start(*m_window);
+        if (!m_resourceLock.owns_lock()) m_resourceLock.lock();
+
+        m_frame = &m_renderThread.beginFrame();
+        m_currentScene->sRender();
+        m_frame = &m_windowFrame;
+
+        // Input for the next frame, polled now: by the start of that frame the
+        // thread is presenting this one, which the next steps overlap
+        {
+            TRACE_ZONE("sUserInput");
+            sUserInput();
+        }
+        m_renderThread.publish();
+        return;
+    }
+
+    stopRenderThread();
+    m_currentScene->sRender();
+    TRACE_ZONE("display");
+    m_window->display();
+}
+
+// Takes the window back; the render thread may be waiting for the resources
+void GameEngine::stopRenderThread() {
+    if (!m_renderThread.running()) return;
+    if (m_resourceLock.owns_lock()) m_resourceLock.unlock();
+    m_renderThread.stop();
+}
+
+// The render thread replays and presents on the same window: never both at once
+bool GameEngine::pollEvent(sf::Event& event) {
+    std::lock_guard<std::mutex> window(m_renderThread.windowAccess());
+    if (!m_window->pollEvent(event)) return false;
+    m_window->setKeyRepeatEnabled(false);
+    return true;
 }
 
 // Update the sUserInput method to be context-aware
 void GameEngine::sUserInput() {
+    if (m_headless) return;
+
     sf::Event event;
-    while (m_window.pollEvent(event)) {
+    while (pollEvent(event)) {
         // Forward events to ImGui if needed
         if (m_currentScene && m_currentScene->usesImGui() && ImGui::GetCurrentContext() != nullptr)
             ImGui::SFML::ProcessEvent(event);
@@ -184,8 +405,6 @@ void GameEngine::sUserInput() {
             stop();
         }
     
-        m_window.setKeyRepeatEnabled(false);
-    
         if (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased) {
             std::string currentSceneType = m_currentScene->getSceneType();
             bool isPlayScene = (currentSceneType == "PLAY" || currentSceneType == "EDITOR");
@@ -246,6 +465,18 @@ void GameEngine::changeScene(const std::string& sceneName, std::shared_ptr<Scene
 
     //std::cout << "[DEBUG] Switching Scene to: " << sceneName << std::endl;
 
+    // A recording covers play only: game over, menu or story ends it
+    if (m_recording && sceneName != "PLAY") {
+        finishRecording();
+    }
+
+    // Its last frame points into the scene being replaced
+    stopRenderThread();
+
+    // Loading isn't simulated time
+    m_clock.restart();
+    m_accumulator = 0.f;
+
     clearActions();
     
     // Store the new scene properly
@@ -264,8 +495,10 @@ void GameEngine::restartLevel() {
 
 // Stops the game engine properly
 void GameEngine::stop() {
+    finishRecording();
+    stopRenderThread();
     m_running = false;
-    m_window.close();
+    if (m_window) m_window->close();
 }
 
 // Clears all queued actions
@@ -277,6 +510,10 @@ void GameEngine::clearActions() {
 }
 
 // Check if there are pending actions
+void GameEngine::pushAction(const Action& action) {
+    m_actionQueue.push(action);
+}
+
 bool GameEngine::hasActions() const {
     return !m_actionQueue.empty();
 }
@@ -293,7 +530,18 @@ Action GameEngine::popAction() {
 
 // Access the game window
 sf::RenderWindow& GameEngine::window() {
-    return m_window;
+    return *m_window;
+}
+
+sf::Vector2u GameEngine::windowSize() const {
+    if (m_window) return m_window->getSize();
+    return m_headlessSize;
+}
+
+sf::View GameEngine::defaultView() const {
+    if (m_window) return m_window->getDefaultView();
+    sf::Vector2u size = windowSize();
+    return sf::View(sf::FloatRect(0.f, 0.f, static_cast<float>(size.x), static_cast<float>(size.y)));
 }
 
 // Get delta time
@@ -314,7 +562,7 @@ void GameEngine::setCameraView(const sf::View& view) {
     sf::FloatRect viewport(0, 0, 1, 1);
     
     // If needed, add letterboxing/pillarboxing to maintain aspect ratio
-    float windowRatio = m_window.getSize().x / static_cast<float>(m_window.getSize().y);
+    float windowRatio = windowSize().x / static_cast<float>(windowSize().y);
     float viewRatio = m_referenceResolution.x / m_referenceResolution.y;
     
     if (windowRatio < viewRatio) {
@@ -331,7 +579,7 @@ void GameEngine::setCameraView(const sf::View& view) {
     }
     
     m_cameraView.setViewport(viewport);
-    m_window.setView(m_cameraView);
+    if (m_window) m_window->setView(m_cameraView);
 }
 
 void GameEngine::scheduleLevelChange(const std::string& levelPath) {
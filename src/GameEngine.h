@@ -5,13 +5,21 @@
 #include <map>
 #include <queue>
 #include <string>
+#include <cstdint>
 #include "Assets.hpp"
 #include "Action.hpp"
 #include "Scene.h"
+#include "DrawList.h"
+#include "RenderThread.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "InputRecording.h"
 
 class GameEngine {
 public:
-    GameEngine(const std::string& path);
+    // headless: no window and no GL context at all (no textures either), for
+    // running the simulation on a machine without a display (see headless_main.cpp)
+    GameEngine(const std::string& path, bool headless = false);
 
     // Scene management
     void changeScene(const std::string& sceneName, std::shared_ptr<Scene> scene);
@@ -32,15 +40,54 @@ public:
     bool isRunning() const;
     void run();
     void update();
+    void step();                    // one FIXED_STEP without a window (headless)
     void stop();
+    uint64_t frameCount() const { return m_frameCount; }
+    uint64_t stepCount() const { return m_stepCount; }   // fixed steps since start / recording / replay
+
+    // Record / replay (InputRecording). recordTo() arms recording: it starts
+    // with the next loadLevel() (reseeding random()) and is written when the
+    // game leaves play (game over, menu) or stops.
+    void recordTo(const std::string& path) { m_recordPath = path; }
+    // Headless only: reseeds, loads the recorded level, and step() then feeds
+    // the recorded actions and checks the checksums
+    bool startReplay(const std::string& path);
+    bool replayFinished() const { return m_replay && m_stepCount >= m_replay->steps; }
+    size_t replayChecksumsMatched() const { return m_replayMatched; }
+    uint64_t replayDivergedAt() const { return m_replayDivergedAt; }   // 0: never
+
+    // Scenes are updated in fixed steps (the rate the game was tuned at);
+    // a long frame runs at most MAX_STEPS_PER_FRAME and drops the rest
+    static constexpr float FIXED_STEP = 1.f / 100.f;
+    static constexpr int MAX_STEPS_PER_FRAME = 5;
+    // How far rendering is between the last two steps, [0, 1)
+    float interpolation() const { return m_interpolation; }
+
+    // Render thread (off by default, main.cpp: --render-thread). Only scenes
+    // that draw to frame() are drawn by it, the others stay on this thread.
+    void setRenderThreaded(bool threaded) { m_renderThreaded = threaded; }
+    bool isRenderThreaded() const { return m_renderThreaded; }
+    // Wrap pure simulation in this so the render thread can draw meanwhile
+    RenderOverlap overlapRendering() { return RenderOverlap(m_resourceLock); }
 
     // Action management
     void clearActions();
+    void pushAction(const Action& action);
     bool hasActions() const;
     Action popAction();
 
     // Access
-    sf::RenderWindow& window();
+    bool isHeadless() const { return m_headless; }
+    sf::RenderWindow& window();             // not in headless mode
+    // Window size / default view for view math; headless: the reference resolution
+    sf::Vector2u windowSize() const;
+    sf::View defaultView() const;
+    // Per-system timings of the last frames (PROFILE_ZONE)
+    Profiler& profiler() { return m_profiler; }
+    // All randomness of the simulation goes through this
+    Random& random() { return m_random; }
+    // Where drawsToFrame() scenes draw: the window, or the frame being recorded
+    DrawList& frame() { return *m_frame; }
     float getDeltaTime();
     Assets& assets();
     
@@ -59,13 +106,41 @@ public:
 
 private:
     void sUserInput();
+    bool pollEvent(sf::Event& event);
+    void render();
+    void processTransitions();
+    void stopRenderThread();
+    void applyActions();
+    void simulateStep(Scene& scene);
+    void finishRecording();
 
-    sf::RenderWindow m_window;
+    std::unique_ptr<sf::RenderWindow> m_window;   // null when headless
+    bool m_headless = false;
+    DrawList m_windowFrame;
+    DrawList* m_frame = &m_windowFrame;
+    RenderThread m_renderThread;
+    std::unique_lock<std::mutex> m_resourceLock{m_renderThread.resources(), std::defer_lock};
+    bool m_renderThreaded = false;
     sf::Clock m_clock;
+    float m_accumulator = 0.f;      // frame time not simulated yet
+    float m_interpolation = 0.f;
     sf::View m_cameraView;
     Assets m_assets;
+    Profiler m_profiler;
+    Random m_random;
+    sf::Vector2u m_headlessSize;    // windowSize() without a window
+
+    uint64_t m_stepCount = 0;
+    std::string m_recordPath;
+    std::unique_ptr<InputRecording> m_recording;   // while recording
+    std::unique_ptr<InputRecording> m_replay;      // while replaying
+    size_t m_replayAction = 0;                     // next entry of m_replay->actions
+    size_t m_replayChecksum = 0;
+    size_t m_replayMatched = 0;
+    uint64_t m_replayDivergedAt = 0;
     
     bool m_running = true;
+    uint64_t m_frameCount = 0;   // frames presented so far
     bool m_showEndingScreen = false;
     
     std::shared_ptr<Scene> m_currentScene;
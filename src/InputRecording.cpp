@@ -0,0 +1,82 @@
+#include "InputRecording.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool InputRecording::save(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[ERROR] Failed to open recording file: " << path << std::endl;
+        return false;
+    }
+
+    file << "# Input recording: replay with sfml_headless --replay <file>\n"
+         << "seed " << seed << "\n"
+         << "level " << level << "\n"
+         << "language " << language << "\n"
+         << "window " << windowSize.x << " " << windowSize.y << "\n";
+    for (const Entry& entry : actions) {
+        file << "action " << entry.step << " " << entry.action.name() << " " << entry.action.type() << "\n";
+    }
+    for (const Checksum& checksum : checksums) {
+        file << "checksum " << checksum.step << " " << checksum.hash << "\n";
+    }
+    file << "steps " << steps << "\n";
+
+    if (!file) {
+        std::cerr << "[ERROR] Failed to write recording file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool InputRecording::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[ERROR] Failed to open recording file: " << path << std::endl;
+        return false;
+    }
+
+    *this = InputRecording();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream stream(line);
+        std::string type;
+        stream >> type;
+        bool ok = true;
+        if (type == "seed") {
+            ok = static_cast<bool>(stream >> seed);
+        } else if (type == "level") {
+            ok = static_cast<bool>(stream >> level);
+        } else if (type == "language") {
+            ok = static_cast<bool>(stream >> language);
+        } else if (type == "window") {
+            ok = static_cast<bool>(stream >> windowSize.x >> windowSize.y);
+        } else if (type == "action") {
+            Entry entry;
+            std::string name, actionType;
+            ok = static_cast<bool>(stream >> entry.step >> name >> actionType);
+            entry.action = Action(name, actionType);
+            if (ok) actions.push_back(entry);
+        } else if (type == "checksum") {
+            Checksum checksum;
+            ok = static_cast<bool>(stream >> checksum.step >> checksum.hash);
+            if (ok) checksums.push_back(checksum);
+        } else if (type == "steps") {
+            ok = static_cast<bool>(stream >> steps);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cerr << "[WARNING] Skipping recording line: " << line << std::endl;
+        }
+    }
+
+    if (level.empty()) {
+        std::cerr << "[ERROR] Recording has no level: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
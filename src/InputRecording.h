@@ -0,0 +1,41 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Action.hpp"
+
+// A play session as the simulation saw it (main.cpp --record=<file>,
+// headless_main --replay <file>): what it started from, the actions applied
+// before each fixed step, and Scene::stateHash() every CHECKSUM_INTERVAL
+// steps so a replay can tell where it stopped matching.
+//
+// Text file, one entry per line:
+//   seed <n> / level <file in levels/> / language <name> / window <w> <h>
+//   action <step> <NAME> <START|END>
+//   checksum <step> <hash>
+//   steps <n>
+struct InputRecording {
+    static constexpr uint64_t CHECKSUM_INTERVAL = 100;
+
+    struct Entry {
+        uint64_t step = 0;      // applied before this step (0 = the first)
+        Action action;
+    };
+    struct Checksum {
+        uint64_t step = 0;      // after this many steps
+        uint64_t hash = 0;
+    };
+
+    uint32_t seed = 0;
+    std::string level;
+    std::string language = "English";
+    sf::Vector2u windowSize;    // view math depends on it
+    std::vector<Entry> actions;         // in step order
+    std::vector<Checksum> checksums;    // in step order
+    uint64_t steps = 0;                 // length of the session
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
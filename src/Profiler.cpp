@@ -0,0 +1,40 @@
+#include "Profiler.h"
+#include <algorithm>
+
+void Profiler::endFrame() {
+    m_history[m_next] = m_current;
+    m_current.fill(0.f);
+    m_next = (m_next + 1) % HISTORY;
+    m_count = std::min(m_count + 1, HISTORY);
+}
+
+float Profiler::sample(ProfileZone zone, size_t age) const {
+    if (age >= m_count) return 0.f;
+    size_t slot = (m_next + HISTORY - 1 - age) % HISTORY;
+    return m_history[slot][static_cast<size_t>(zone)];
+}
+
+float Profiler::frameTotal(size_t age) const {
+    float total = 0.f;
+    for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; ++zone) {
+        total += sample(static_cast<ProfileZone>(zone), age);
+    }
+    return total;
+}
+
+float Profiler::average(ProfileZone zone) const {
+    if (m_count == 0) return 0.f;
+    float sum = 0.f;
+    for (size_t age = 0; age < m_count; ++age) {
+        sum += sample(zone, age);
+    }
+    return sum / static_cast<float>(m_count);
+}
+
+float Profiler::peak(ProfileZone zone) const {
+    float highest = 0.f;
+    for (size_t age = 0; age < m_count; ++age) {
+        highest = std::max(highest, sample(zone, age));
+    }
+    return highest;
+}
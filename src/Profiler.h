@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "Trace.h"      // PROFILER_ENABLED
+
+// Timed parts of a play frame: the systems of Scene_Play::update and the renderer
+enum class ProfileZone : uint8_t {
+    Movement,
+    EnemyAI,
+    Collision,
+    Animation,
+    Fragments,
+    Graves,
+    Sword,
+    Lifespan,
+    Ammo,
+    BurstFire,
+    Render,
+    Count
+};
+
+static constexpr size_t PROFILE_ZONE_COUNT = static_cast<size_t>(ProfileZone::Count);
+
+inline const char* profileZoneName(ProfileZone zone) {
+    switch (zone) {
+        case ProfileZone::Movement:  return "sMovement";
+        case ProfileZone::EnemyAI:   return "sEnemyAI";
+        case ProfileZone::Collision: return "sCollision";
+        case ProfileZone::Animation: return "sAnimation";
+        case ProfileZone::Fragments: return "fragments";
+        case ProfileZone::Graves:    return "graves";
+        case ProfileZone::Sword:     return "sUpdateSword";
+        case ProfileZone::Lifespan:  return "sLifespan";
+        case ProfileZone::Ammo:      return "sAmmoSystem";
+        case ProfileZone::BurstFire: return "burstFire";
+        case ProfileZone::Render:    return "render";
+        default:                     return "unknown";
+    }
+}
+
+// Milliseconds spent in each zone per drawn frame (summed over the frame's
+// fixed steps), for the last HISTORY frames. Owned by GameEngine, which closes
+// a frame after presenting it; the zones are timed on the main thread only.
+class Profiler {
+public:
+    static constexpr size_t HISTORY = 300;
+
+    void add(ProfileZone zone, float ms) { m_current[static_cast<size_t>(zone)] += ms; }
+    void endFrame();
+
+    size_t frames() const { return m_count; }
+    // age 0 is the last finished frame
+    float sample(ProfileZone zone, size_t age) const;
+    float frameTotal(size_t age) const;
+    float average(ProfileZone zone) const;
+    float peak(ProfileZone zone) const;
+
+private:
+    std::array<std::array<float, PROFILE_ZONE_COUNT>, HISTORY> m_history{};   // ring
+    std::array<float, PROFILE_ZONE_COUNT> m_current{};
+    size_t m_next = 0;      // slot the next finished frame goes to
+    size_t m_count = 0;
+};
+
+// Times its scope into one zone (and the trace, when it is on)
+class ProfileScope {
+public:
+    ProfileScope(Profiler& profiler, ProfileZone zone)
+        : m_profiler(profiler), m_zone(zone), m_start(std::chrono::steady_clock::now())
+    {
+    }
+    ~ProfileScope() {
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        std::chrono::duration<float, std::milli> elapsed = end - m_start;
+        m_profiler.add(m_zone, elapsed.count());
+        if (Trace::active()) Trace::record(profileZoneName(m_zone), m_start, end);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler& m_profiler;
+    ProfileZone m_zone;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#if PROFILER_ENABLED
+#define PROFILE_ZONE(profiler, zone) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)((profiler), ProfileZone::zone)
+#define PROFILE_END_FRAME(profiler) (profiler).endFrame()
+#else
+#define PROFILE_ZONE(profiler, zone) ((void)0)
+#define PROFILE_END_FRAME(profiler) ((void)0)
+#endif
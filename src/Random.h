@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+// The game's only source of randomness (GameEngine::random()). Seeded once per
+// session, and again when an input recording starts or is replayed, so a
+// replayed session draws exactly the same numbers. Ranges are mapped here
+// rather than with <random>'s distributions, whose results differ between
+// standard libraries; std::mt19937 itself is the same everywhere.
+class Random {
+public:
+    explicit Random(uint32_t seed = 5489u) { reseed(seed); }
+
+    void reseed(uint32_t seed) {
+        m_seed = seed;
+        m_engine.seed(seed);
+    }
+    uint32_t seed() const { return m_seed; }
+
+    uint32_t next() { return static_cast<uint32_t>(m_engine()); }
+
+    // [0, n), what rand() % n was used for
+    int below(int n) { return n > 0 ? static_cast<int>(next() % static_cast<uint32_t>(n)) : 0; }
+    // [min, max]
+    int intIn(int min, int max) { return min + below(max - min + 1); }
+    // [0, 1), 24 bits
+    float unit() { return static_cast<float>(next() >> 8) * (1.f / 16777216.f); }
+    // [min, max)
+    float floatIn(float min, float max) { return min + (max - min) * unit(); }
+
+private:
+    std::mt19937 m_engine;
+    uint32_t m_seed = 0;
+};
@@ -0,0 +1,99 @@
+#include "RenderThread.h"
+#include <utility>
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::start(sf::RenderWindow& window) {
+    if (running()) return;
+    m_window = &window;
+    {
+        std::lock_guard<std::mutex> lock(m_swap);
+        m_fresh = false;
+        m_stopping = false;
+    }
+    m_window->setActive(false);   // a context is current on one thread at a time
+    m_thread = std::thread(&RenderThread::run, this);
+}
+
+void RenderThread::stop() {
+    if (!running()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_swap);
+        m_stopping = true;
+    }
+    m_swapped.notify_all();
+    m_thread.join();
+    m_window->setActive(true);
+}
+
+void RenderThread::waitForPickup() {
+    std::unique_lock<std::mutex> lock(m_swap);
+    m_swapped.wait(lock, [this] { return !m_fresh || m_stopping; });
+}
+
+DrawList& RenderThread::beginFrame() {
+    // m_recording only changes in publish(), on this same thread
+    DrawList& frame = m_frames[m_recording];
+    frame.begin(m_window->getSize(), m_window->getDefaultView());
+    return frame;
+}
+
+void RenderThread::publish() {
+    {
+        std::lock_guard<std::mutex> lock(m_swap);
+        std::swap(m_recording, m_ready);
+        m_fresh = true;
+    }
+    m_swapped.notify_all();
+}
+
+void RenderThread::run() {
+    Trace::setThreadName("render");
+    m_window->setActive(true);
+
+    for (;;) {
+        // Pick up the newest frame: this is what waitForPickup() waits for
+        {
+            std::unique_lock<std::mutex> lock(m_swap);
+            m_swapped.wait(lock, [this] { return m_fresh || m_stopping; });
+            if (m_stopping) break;
+            std::swap(m_drawing, m_ready);
+            m_fresh = false;
+        }
+        m_swapped.notify_all();
+
+        std::unique_lock<std::mutex> resources(m_resources);
+        bool retaken = false;
+        {
+            std::lock_guard<std::mutex> lock(m_swap);
+            if (m_stopping) break;
+            // A newer frame was recorded while we waited: ours may point at
+            // something that was freed since, draw that one instead
+            if (m_fresh) {
+                std::swap(m_drawing, m_ready);
+                m_fresh = false;
+                retaken = true;
+            }
+        }
+        if (retaken) m_swapped.notify_all();
+
+        // The main thread polls events on this same window, and SFML windows
+        // aren't safe to use from two threads at once: the window mutex
+        // covers the replay and display() (and only pollEvent() over there)
+        std::lock_guard<std::mutex> window(m_windowAccess);
+        {
+            TRACE_ZONE("replay");
+            m_frames[m_drawing].replay(*m_window);
+        }
+        // The frame no longer needs the resources: the simulation runs its
+        // next steps while this one is presented
+        resources.unlock();
+
+        TRACE_ZONE("display");
+        m_window->display();
+    }
+
+    m_window->setActive(false);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "DrawList.h"
+#include "Trace.h"
+
+// Optional render thread (--render-thread). While it runs it owns the
+// window's GL context: the simulation records each frame into a DrawList and
+// publishes it, the thread replays the newest published frame and presents it.
+//
+// Three DrawLists rotate: one being recorded, the newest published, the one
+// being drawn. Publishing never waits for drawing; the simulation instead
+// waits in waitForPickup() until its last frame was picked up, so it runs at
+// most one frame ahead at the display's pace.
+//
+// Recorded frames point at textures and fonts, so the resource mutex is held
+// by the simulation for the whole frame except inside a RenderOverlap (pure
+// simulation), and by the render thread while it replays. display() runs
+// outside it, overlapping the next frame's steps. The window itself is
+// guarded by windowAccess(): the thread holds it to replay and present, the
+// main thread only around pollEvent() (GameEngine::pollEvent). The thread replays the newest frame published before it
+// got the mutex, so anything destroyed while recording a newer frame (an
+// evicted background tile) is never drawn. Scene changes stop the thread.
+class RenderThread {
+public:
+    RenderThread() = default;
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // Hands the window's context to the thread / takes it back.
+    // stop() must be called without holding the resource mutex.
+    void start(sf::RenderWindow& window);
+    void stop();
+    bool running() const { return m_thread.joinable(); }
+
+    std::mutex& resources() { return m_resources; }
+    std::mutex& windowAccess() { return m_windowAccess; }
+
+    // Simulation side
+    void waitForPickup();
+    DrawList& beginFrame();     // the back buffer, emptied for the window
+    void publish();
+
+private:
+    void run();
+
+    sf::RenderWindow* m_window = nullptr;
+    std::thread m_thread;
+    std::mutex m_resources;
+    std::mutex m_windowAccess;  // taken after m_resources when both are held
+
+    // Guarded by m_swap
+    std::mutex m_swap;
+    std::condition_variable m_swapped;
+    DrawList m_frames[3];
+    int m_recording = 0;
+    int m_ready = 1;
+    int m_drawing = 2;
+    bool m_fresh = false;       // m_ready holds a frame not picked up yet
+    bool m_stopping = false;
+};
+
+// Pure simulation scope: releases the resource mutex (if held) so the render
+// thread can draw the previous frame meanwhile. Nothing inside may touch the
+// window, views, textures, fonts or create/change scenes.
+class RenderOverlap {
+public:
+    explicit RenderOverlap(std::unique_lock<std::mutex>& lock)
+        : m_lock(lock), m_owned(lock.owns_lock())
+    {
+        if (m_owned) m_lock.unlock();
+    }
+    ~RenderOverlap() {
+        if (m_owned) m_lock.lock();
+    }
+
+    RenderOverlap(const RenderOverlap&) = delete;
+    RenderOverlap& operator=(const RenderOverlap&) = delete;
+
+private:
+    std::unique_lock<std::mutex>& m_lock;
+    bool m_owned;
+};
@@ -1,4 +1,6 @@
 #include "Scene.h"
+#include "GameEngine.h"
+#include <cassert>
 
 Scene::Scene(GameEngine& game) : m_game(game) {}
 
@@ -15,3 +17,9 @@ void Scene::registerCommonActions() {
 void Scene::togglePause() {
     m_paused = !m_paused;
 }
+
+void Scene::beginDraw() {
+    uint64_t frame = m_game.frameCount();
+    assert(frame != m_lastDrawnFrame && "Scene drawn twice in the same frame");
+    m_lastDrawnFrame = frame;
+}
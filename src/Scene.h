@@ -3,6 +3,7 @@
 #include <SFML/Graphics.hpp>
 #include <unordered_map>
 #include <string>
+#include <cstdint>
 #include "Action.hpp"
 
 class GameEngine;
@@ -13,6 +14,9 @@ protected:
     std::unordered_map<int, std::string> m_actionMap;
     bool m_paused = false;
 
+    // First call of every sRender(): asserts the scene is drawn at most once per frame
+    void beginDraw();
+
 public:
     Scene(GameEngine& game);
     virtual ~Scene() = default;
@@ -25,9 +29,18 @@ public:
     virtual void update(float deltaTime) = 0;
     virtual void sRender() = 0;
     virtual bool usesImGui() const { return false; }
+    // Draws through GameEngine::frame() only (never window()), so it can be
+    // recorded and drawn by the render thread
+    virtual bool drawsToFrame() const { return false; }
     
     // Added method to identify scene type for context-aware input handling
     virtual std::string getSceneType() const { return "UNKNOWN"; }
+
+    // Fingerprint of the simulation state: a replay compares it with the recording's
+    virtual uint64_t stateHash() const { return 0; }
     
     const std::unordered_map<int, std::string>& getActionMap() const { return m_actionMap; }
+
+private:
+    uint64_t m_lastDrawnFrame = UINT64_MAX;
 };
@@ -126,12 +126,11 @@ void Scene_GameOver::renderGameOverText()
 
 void Scene_GameOver::sRender() 
 {
+    beginDraw();
     m_game.window().setView(m_game.window().getDefaultView());
     m_game.window().clear(sf::Color(30, 30, 30));
     
     renderGameOverText();
-    
-    m_game.window().display();
 }
 
 void Scene_GameOver::update(float deltaTime) 
@@ -158,6 +158,7 @@ void Scene_LevelEditor::update(float deltaTime) {
 }
 
 void Scene_LevelEditor::sRender() {
+    beginDraw();
     m_game.window().clear(sf::Color(100, 100, 255));
     m_game.window().setView(m_cameraView);
 
@@ -186,7 +187,6 @@ void Scene_LevelEditor::sRender() {
     m_game.window().setView(m_game.window().getDefaultView());
     renderImGui();
     ImGui::SFML::Render(m_game.window());
-    m_game.window().display();
 }
 
 
@@ -259,14 +259,14 @@ void Scene_LevelEditor::placePlayer(int gridX, int gridY) {
     float realY = gridY * tileSize;
     
     // First, check if a player already exists and remove it if it does
-    auto& players = m_entityManager.getEntities("player");
+    auto players = m_entityManager.getEntities(TagId::Player);
     for (auto& player : players) {
         player->destroy();
         std::cout << "[DEBUG] Existing player removed\n";
     }
     
     // Create new player at the specified position
-    auto player = m_entityManager.addEntity("player");
+    auto player = m_entityManager.addEntity(TagId::Player);
     player->add<CTransform>(Vec2<float>(realX, realY));
     
 // Add the player animation
@@ -286,7 +286,7 @@ void Scene_LevelEditor::placePlayer(int gridX, int gridY) {
 }
 
 void Scene_LevelEditor::removePlayer() {
-    auto& players = m_entityManager.getEntities("player");
+    auto players = m_entityManager.getEntities(TagId::Player);
     if (!players.empty()) {
         for (auto& player : players) {
             player->destroy();
@@ -300,7 +300,7 @@ void Scene_LevelEditor::removePlayer() {
 void Scene_LevelEditor::placeTile(int gridX, int gridY) {
     float realX = gridX * tileSize;
     float realY = gridY * tileSize;
-    for (auto& tile : m_entityManager.getEntities("tile")) {
+    for (auto& tile : m_entityManager.getEntities(TagId::Tile)) {
         auto& transform = tile->get<CTransform>();
         if (std::abs(transform.pos.x - realX) < 0.1f &&
             std::abs(transform.pos.y - realY) < 0.1f) {
@@ -308,7 +308,7 @@ void Scene_LevelEditor::placeTile(int gridX, int gridY) {
             return;
         }
     }
-    auto tile = m_entityManager.addEntity("tile");
+    auto tile = m_entityManager.addEntity(TagId::Tile);
     tile->add<CTransform>(Vec2<float>(realX, realY));
     std::string fullName = worldcategory + m_selectedTile;
     if (m_game.assets().hasAnimation(fullName)) {
@@ -322,7 +322,7 @@ void Scene_LevelEditor::placeTile(int gridX, int gridY) {
 void Scene_LevelEditor::placeDec(int gridX, int gridY) {
     float realX = gridX * tileSize;
     float realY = gridY * tileSize;
-    for (auto& dec : m_entityManager.getEntities("decoration")) {
+    for (auto& dec : m_entityManager.getEntities(TagId::Decoration)) {
         auto& transform = dec->get<CTransform>();
         if (std::abs(transform.pos.x - realX) < 0.1f &&
             std::abs(transform.pos.y - realY) < 0.1f) {
@@ -330,7 +330,7 @@ void Scene_LevelEditor::placeDec(int gridX, int gridY) {
             return;
         }
     }
-    auto dec = m_entityManager.addEntity("decoration");
+    auto dec = m_entityManager.addEntity(TagId::Decoration);
     dec->add<CTransform>(Vec2<float>(realX, realY));
     std::string fullName = worldcategory + m_selectedDec;
     if (m_game.assets().hasAnimation(fullName)) {
@@ -344,7 +344,7 @@ void Scene_LevelEditor::placeDec(int gridX, int gridY) {
 void Scene_LevelEditor::placeEnemy(int gridX, int gridY) {
     float realX = gridX * tileSize;
     float realY = gridY * tileSize;
-    for (auto& enemy : m_entityManager.getEntities("enemy")) {
+    for (auto& enemy : m_entityManager.getEntities(TagId::Enemy)) {
         auto& transform = enemy->get<CTransform>();
         if (std::abs(transform.pos.x - realX) < 0.1f &&
             std::abs(transform.pos.y - realY) < 0.1f) {
@@ -352,7 +352,7 @@ void Scene_LevelEditor::placeEnemy(int gridX, int gridY) {
             return;
         }
     }
-    auto enemy = m_entityManager.addEntity("enemy");
+    auto enemy = m_entityManager.addEntity(TagId::Enemy);
     enemy->add<CTransform>(Vec2<float>(realX, realY));
     std::string fullName = worldcategory + "Stand" + m_selectedEnemy;
     if (m_game.assets().hasAnimation(fullName))
@@ -367,7 +367,7 @@ void Scene_LevelEditor::removeTile(int gridX, int gridY) {
     float realX = gridX * tileSize;
     float realY = gridY * tileSize;
     
-    auto& tiles = m_entityManager.getEntities("tile");
+    auto tiles = m_entityManager.getEntities(TagId::Tile);
     for (auto& tile : tiles) {
         auto& transform = tile->get<CTransform>();
         if (std::abs(transform.pos.x - realX) < 0.1f &&
@@ -383,7 +383,7 @@ void Scene_LevelEditor::removeDec(int gridX, int gridY) {
     float realX = gridX * tileSize;
     float realY = gridY * tileSize;
     
-    auto& decs = m_entityManager.getEntities("decoration");
+    auto decs = m_entityManager.getEntities(TagId::Decoration);
     for (auto& dec : decs) {
         auto& transform = dec->get<CTransform>();
         if (std::abs(transform.pos.x - realX) < 0.1f &&
@@ -400,7 +400,7 @@ void Scene_LevelEditor::removeEnemy(int gridX, int gridY) {
     float realX = gridX * tileSize;
     float realY = gridY * tileSize;
     
-    auto& enemies = m_entityManager.getEntities("enemy");
+    auto enemies = m_entityManager.getEntities(TagId::Enemy);
     for (auto& enemy : enemies) {
         auto& transform = enemy->get<CTransform>();
         if (std::abs(transform.pos.x - realX) < 0.1f &&
@@ -629,7 +629,7 @@ void Scene_LevelEditor::saveLevelToFile(const std::string& savePath) {
     // ========================
     // Save Tiles
     // ========================
-    for (auto& tile : m_entityManager.getEntities("tile")) {
+    for (auto& tile : m_entityManager.getEntities(TagId::Tile)) {
         auto& transform = tile->get<CTransform>();
         int gridX = static_cast<int>(transform.pos.x / tileSize);
         int gridY = static_cast<int>(transform.pos.y / tileSize);
@@ -654,7 +654,7 @@ void Scene_LevelEditor::saveLevelToFile(const std::string& savePath) {
     }
 
     // Save Player
-    auto& players = m_entityManager.getEntities("player");
+    auto players = m_entityManager.getEntities(TagId::Player);
     if (!players.empty()) {
         auto& player = players.front();
         auto& transform = player->get<CTransform>();
@@ -668,7 +668,7 @@ void Scene_LevelEditor::saveLevelToFile(const std::string& savePath) {
     // ========================
     // Save Decorations
     // ========================
-    for (auto& dec : m_entityManager.getEntities("decoration")) {
+    for (auto& dec : m_entityManager.getEntities(TagId::Decoration)) {
         auto& transform = dec->get<CTransform>();
         int gridX = static_cast<int>(transform.pos.x / tileSize);
         int gridY = static_cast<int>(transform.pos.y / tileSize);
@@ -695,7 +695,7 @@ void Scene_LevelEditor::saveLevelToFile(const std::string& savePath) {
     // ========================
     // Save Enemies
     // ========================
-    for (auto& enemy : m_entityManager.getEntities("enemy")) {
+    for (auto& enemy : m_entityManager.getEntities(TagId::Enemy)) {
         auto& transform = enemy->get<CTransform>();
         int gridX = static_cast<int>(transform.pos.x / tileSize);
         int gridY = static_cast<int>(transform.pos.y / tileSize);
@@ -767,7 +767,7 @@ void Scene_LevelEditor::loadLevel(const std::string& filePath) {
             file >> assetType >> fileGridX >> fileGridY;
             int gridX = fileGridX;
             int gridY = worldHeight - 1 - fileGridY;
-            auto entity = m_entityManager.addEntity("tile");
+            auto entity = m_entityManager.addEntity(TagId::Tile);
             entity->add<CTransform>(Vec2<float>(gridX * tileSize, gridY * tileSize));
 
             std::string fullAsset = worldcategory + assetType;
@@ -786,7 +786,7 @@ void Scene_LevelEditor::loadLevel(const std::string& filePath) {
             file >> assetType >> fileGridX >> fileGridY;
             int gridX = fileGridX;
             int gridY = worldHeight - 1 - fileGridY;
-            auto entity = m_entityManager.addEntity("decoration");
+            auto entity = m_entityManager.addEntity(TagId::Decoration);
             entity->add<CTransform>(Vec2<float>(gridX * tileSize, gridY * tileSize));
             std::string fullAsset = worldcategory + assetType;
             if (m_game.assets().hasAnimation(fullAsset)) {
@@ -801,7 +801,7 @@ void Scene_LevelEditor::loadLevel(const std::string& filePath) {
             file >> fileGridX >> fileGridY;
             int gridX = fileGridX;
             int gridY = worldHeight - 1 - fileGridY;
-            auto entity = m_entityManager.addEntity("player");
+            auto entity = m_entityManager.addEntity(TagId::Player);
             entity->add<CTransform>(Vec2<float>(gridX * tileSize, gridY * tileSize));
             
             std::string standAnim = "PlayerStand";
@@ -820,7 +820,7 @@ void Scene_LevelEditor::loadLevel(const std::string& filePath) {
             file >> enemyType >> fileGridX >> fileGridY;
             int gridX = fileGridX;
             int gridY = worldHeight - 1 - fileGridY;
-            auto entity = m_entityManager.addEntity("enemy");
+            auto entity = m_entityManager.addEntity(TagId::Enemy);
             entity->add<CTransform>(Vec2<float>(gridX * tileSize, gridY * tileSize));
             entity->add<CEnemyAI>(getEnemyType(enemyType));
             // Build the stand animation name as "WorldCategory" + "StandAnim" + enemyType.
@@ -846,19 +846,19 @@ void Scene_LevelEditor::loadLevel(const std::string& filePath) {
 }
 
 void Scene_LevelEditor::printEntities() {
-    auto tiles = m_entityManager.getEntities("tile");
+    auto tiles = m_entityManager.getEntities(TagId::Tile);
     std::cout << "[DEBUG] Entities (tile): " << tiles.size() << "\n";
     for (auto& tile : tiles) {
         auto& transform = tile->get<CTransform>();
         std::cout << "[DEBUG] Tile: pos (" << transform.pos.x << ", " << transform.pos.y << ")\n";
     }
-    auto decs = m_entityManager.getEntities("decoration");
+    auto decs = m_entityManager.getEntities(TagId::Decoration);
     std::cout << "[DEBUG] Entities (decoration): " << decs.size() << "\n";
     for (auto& dec : decs) {
         auto& transform = dec->get<CTransform>();
         std::cout << "[DEBUG] Decoration: pos (" << transform.pos.x << ", " << transform.pos.y << ")\n";
     }
-    auto enemies = m_entityManager.getEntities("enemy");
+    auto enemies = m_entityManager.getEntities(TagId::Enemy);
     std::cout << "[DEBUG] Entities (enemy): " << enemies.size() << "\n";
     for (auto& enemy : enemies) {
         auto& transform = enemy->get<CTransform>();
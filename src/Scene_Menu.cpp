@@ -91,6 +91,7 @@ void Scene_Menu::loadLevelOptions() {
 }
 
 void Scene_Menu::sRender() {
+    beginDraw();
     m_game.window().clear(sf::Color(0, 0, 0));
 
     sf::Text text;
@@ -164,8 +165,6 @@ void Scene_Menu::sRender() {
 
 m_game.window().draw(text);
     m_game.window().draw(text);
-
-    m_game.window().display();
 }
 
 void Scene_Menu::renderLanguageMenu(sf::Text& text, float startY, float spacing) {
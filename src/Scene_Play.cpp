@@ -11,6 +11,7 @@
 #include <random>
 #include <filesystem>
 #include <algorithm>
+#include <bit>
 #include "systems/PlayRenderer.h"
 #include "systems/AnimationSystem.h"
 #include <cmath>
@@ -28,33 +29,33 @@ bool wasInDialogue = false;
 void Scene_Play::initializeCamera()
 {
     // 1) Start with the window's default view
-    m_cameraView = m_game.window().getDefaultView();
-    sf::Vector2u bgSize = m_backgroundTexture.getSize();
-    if (bgSize.x == 0 || bgSize.y == 0) {
-        // Safety check: if the texture didn't load properly, just return
-        return;
-    }
+    m_cameraView = m_game.defaultView();
+    // From the PNG header, so headless runs (no background layer) start
+    // from the same camera as the window
+    sf::Vector2u bgSize = ParallaxBackground::readImageSize(m_backgroundPath);
 
     // 4) Center the camera on the middle of the background
-    float centerX = static_cast<float>(bgSize.x) / 2.f;
-    float centerY = static_cast<float>(bgSize.y) / 2.f - CAMERA_Y_OFFSET;
-    m_cameraView.setCenter(centerX, centerY);
+    //    (if its size is unknown, keep the default center but still zoom)
+    if (bgSize.x != 0 && bgSize.y != 0) {
+        float centerX = static_cast<float>(bgSize.x) / 2.f;
+        float centerY = static_cast<float>(bgSize.y) / 2.f - CAMERA_Y_OFFSET;
+        m_cameraView.setCenter(centerX, centerY);
+    }
 
     m_cameraView.zoom(Scene_Play::CAMERA_ZOOM);
-
-    // 6) Apply the view to the window
-    m_game.window().setView(m_cameraView);
+    m_prevCameraCenter = m_cameraView.getCenter();
+    // (applied to the window by PlayRenderer, every frame)
 }
 // Then call it from the constructor:
 Scene_Play::Scene_Play(GameEngine& game, const std::string& levelPath)
     : Scene(game),
       m_levelPath(levelPath),
       m_entityManager(),
+      m_tileGrid(),
       m_lastDirection(1.f),
       m_animationSystem(game, m_entityManager, m_lastDirection),
-      m_playRenderer(game, m_entityManager, m_backgroundSprite, m_backgroundTexture, m_cameraView, m_score),
-      m_backgroundTexture(),
-      m_backgroundSprite(),
+      m_playRenderer(game, m_entityManager, m_background, m_cameraView, m_score, m_tileGrid),
+      m_background(),
       m_game(game),
       m_gameOver(false),
       m_levelLoader(game),
@@ -62,11 +63,12 @@ Scene_Play::Scene_Play(GameEngine& game, const std::string& levelPath)
       m_showGrid(false),
       m_backgroundPath(""),
       m_timeofday(""),
-      m_cameraView(game.window().getDefaultView()),
+      m_cameraView(game.defaultView()),
       m_score(0),
       m_movementSystem(game, m_entityManager, m_cameraView, m_lastDirection),
-      m_spawner(game, m_entityManager),
-      m_enemyAISystem(m_entityManager, m_spawner, m_game),
+      m_spawner(game, m_entityManager, m_tileGrid),
+      m_enemyAISystem(m_entityManager, m_tileGrid, m_spawner, m_game),
+      m_collisionSystem(m_entityManager, m_tileGrid, game, &m_spawner, m_score, m_levelPath),
       m_language(game.getLanguage())
 {
     // std::cout << "[DEBUG] Scene_Play constructor: levelPath = " << levelPath << std::endl;
@@ -79,17 +81,16 @@ Scene_Play::Scene_Play(GameEngine& game, const std::string& levelPath)
     selectBackgroundFromLevel(m_levelPath);
     // std::cout << "[DEBUG] Selected background: " << m_backgroundPath << std::endl;
 
-    if (!m_backgroundTexture.loadFromFile(m_backgroundPath)) {
-        std::cerr << "[ERROR] Could not load background image: " << m_backgroundPath << std::endl;
-    } else {
-        m_backgroundTexture.setRepeated(true);
-        m_backgroundSprite.setTexture(m_backgroundTexture);
+    // Decoded on a worker thread; the camera only needs the size from the PNG header
+    if (!m_game.isHeadless()) {
+        m_background.addLayer(m_backgroundPath, 0.f);
     }
 
     // std::cout << "[DEBUG] Initializing Camera...\n";
     initializeCamera();
 
     // Add dialogue system initialization here, right after camera initialization
+    // (also headless: dialogues pause the game, replays must see them)
     // std::cout << "[DEBUG] Initializing Dialogue System...\n";
     initializeDialogues();
 
@@ -181,6 +182,7 @@ void Scene_Play::init()
     registerAction(sf::Keyboard::G, "TOGGLE_GRID");
     registerAction(sf::Keyboard::B, "TOGGLE_BB");
     registerAction(sf::Keyboard::Enter, "SUPERMOVE");
+    registerAction(sf::Keyboard::F3, "TOGGLE_PROFILER");
 
     // << "[DEBUG] Scene_Play::init() - Loading level: " << m_levelPath << std::endl;
 
@@ -196,12 +198,20 @@ void Scene_Play::init()
 
     //Ensure entity manager is clean before loading
     m_entityManager = EntityManager();
+    m_tileGrid.clear();   // its tile pointers belonged to the old manager
+    m_collisionSystem.reset();
+    m_activeSword = EntityHandle();
 
     m_game.setCurrentLevel(m_levelPath);
+    m_playRenderer.setLighting(LightingProfile::forLevel(m_levelPath));
 
     // std::cout << "[DEBUG] Scene_Play::init() - Calling m_levelLoader.load()\n";
     m_levelLoader.load(m_levelPath, m_entityManager);
     // std::cout << "[DEBUG] Scene_Play::init() - Level loaded successfully!\n";
+
+    // Publish the level's entities now and index the tiles once
+    m_entityManager.update();
+    m_tileGrid.build(m_entityManager.getEntities(TagId::Tile), m_entityManager.groupVersion(TagId::Tile));
 }
 //
 // Main Update Function
@@ -211,15 +221,25 @@ void Scene_Play::update(float deltaTime)
     if (!m_gameOver)
     {
         // Update entity manager
-        m_entityManager.update();
-
-        // Update states
-        for (auto& entity : m_entityManager.getEntities()) {
-            if (entity->has<CHealth>())
-                entity->get<CHealth>().update(deltaTime);
-            if (entity->has<CState>())
-                entity->get<CState>().update(deltaTime);
+        {
+            TRACE_ZONE("EntityManager::update");
+            m_entityManager.update();
+            m_tileGrid.sync(m_entityManager.getEntities(TagId::Tile), m_entityManager.groupVersion(TagId::Tile));
         }
+
+        // Frames drawn during this step interpolate from here
+        m_entityManager.each<CTransform>([](Entity&, CTransform& transform) {
+            transform.prevPos = transform.pos;
+        });
+        m_prevCameraCenter = m_cameraView.getCenter();
+
+        // Update states (straight through the component pools)
+        m_entityManager.each<CHealth>([deltaTime](Entity&, CHealth& health) {
+            health.update(deltaTime);
+        });
+        m_entityManager.each<CState>([deltaTime](Entity&, CState& state) {
+            state.update(deltaTime);
+        });
         
         // Update dialogue system first
         if (m_dialogueSystem) {
@@ -228,39 +248,83 @@ void Scene_Play::update(float deltaTime)
         
         // Only process game mechanics if dialogue is not active
         if (!m_dialogueSystem || !m_dialogueSystem->isDialogueActive()) {
-            sMovement(deltaTime);
-            sEnemyAI(deltaTime);
-            sCollision();
-            sAnimation(deltaTime);
-            UpdateFragments(deltaTime);
-            m_spawner.updateGraves(deltaTime);
-            sUpdateSword();
-            sLifespan(deltaTime);
-            sAmmoSystem(deltaTime);
-            updateBurstFire(deltaTime);
-            
-            // Life checks
+            {
+                // Pure simulation: with the render thread on, the previous
+                // frame is drawn meanwhile
+                RenderOverlap overlap = m_game.overlapRendering();
+                [[maybe_unused]] Profiler& profiler = m_game.profiler();
+                { PROFILE_ZONE(profiler, Movement);  sMovement(deltaTime); }
+                { PROFILE_ZONE(profiler, EnemyAI);   sEnemyAI(deltaTime); }
+                { PROFILE_ZONE(profiler, Collision); sCollision(); }
+                { PROFILE_ZONE(profiler, Animation); sAnimation(deltaTime); }
+                { PROFILE_ZONE(profiler, Fragments); UpdateFragments(deltaTime); }
+                { PROFILE_ZONE(profiler, Graves);    m_spawner.updateGraves(deltaTime); }
+                { PROFILE_ZONE(profiler, Sword);     sUpdateSword(); }
+                { PROFILE_ZONE(profiler, Lifespan);  sLifespan(deltaTime); }
+                { PROFILE_ZONE(profiler, Ammo);      sAmmoSystem(deltaTime); }
+                { PROFILE_ZONE(profiler, BurstFire); updateBurstFire(deltaTime); }
+            }
+
+            // Life checks (may change scene)
             lifeCheckEnemyDeath();
             lifeCheckPlayerDeath();
         }
     }
     else
     {
+        if (m_game.isHeadless()) {
+            m_game.restartLevel();
+            return;
+        }
         m_game.window().setView(m_game.window().getDefaultView());
         // std::cout << "[DEBUG] Transitioning to GameOver scene with level path: " << m_levelPath << std::endl;
         m_game.changeScene("GAMEOVER", std::make_shared<Scene_GameOver>(m_game, m_levelPath));
     }
+    // Drawn by GameEngine::render(), once per frame
+}
 
-    // 3) Finally, render
-    sRender();
+// FNV-1a over what the systems write: entities, their positions, velocities
+// and health, the score and the camera (floats by their bits)
+uint64_t Scene_Play::stateHash() const
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    };
+    auto mixFloat = [&mix](float value) { mix(std::bit_cast<uint32_t>(value)); };
+
+    for (Entity* entity : m_entityManager.getEntities()) {
+        mix(entity->id());
+        mix(static_cast<uint64_t>(entity->tag()));
+        if (entity->has<CTransform>()) {
+            const auto& transform = entity->get<CTransform>();
+            mixFloat(transform.pos.x);
+            mixFloat(transform.pos.y);
+            mixFloat(transform.velocity.x);
+            mixFloat(transform.velocity.y);
+        }
+        if (entity->has<CHealth>()) {
+            mix(static_cast<uint64_t>(entity->get<CHealth>().currentHealth));
+        }
+    }
+    mix(static_cast<uint64_t>(m_score));
+    mixFloat(m_cameraView.getCenter().x);
+    mixFloat(m_cameraView.getCenter().y);
+    return hash;
 }
 // Rendering
 //
 
 void Scene_Play::sRender() {
+    beginDraw();
+
     // Update rendering settings
     m_playRenderer.setShowGrid(m_showGrid);
     m_playRenderer.setShowBoundingBoxes(m_showBoundingBoxes);
+    m_playRenderer.setShowProfiler(m_showProfiler);
     m_playRenderer.setScore(m_score);
     m_playRenderer.setTimeOfDay(m_timeofday);
     
@@ -269,8 +333,20 @@ void Scene_Play::sRender() {
         m_playRenderer.setDialogueSystem(m_dialogueSystem.get());
     }
     
+    // Render between the last two steps: the entities through
+    // PlayRenderer::drawPos(), the camera here
+    float alpha = m_game.interpolation();
+    m_playRenderer.setInterpolation(alpha);
+    sf::Vector2f cameraCenter = m_cameraView.getCenter();
+    m_cameraView.setCenter(PlayRenderer::interpolate(m_prevCameraCenter, cameraCenter, alpha));
+
     // Render
-    m_playRenderer.render();
+    {
+        PROFILE_ZONE(m_game.profiler(), Render);
+        m_playRenderer.render();
+    }
+
+    m_cameraView.setCenter(cameraCenter);
 }
 
 //
@@ -291,8 +367,8 @@ void Scene_Play::sAnimation(float deltaTime)
 //Collision Handliong
 //
 void Scene_Play::sCollision() {
-    CollisionSystem collisionSystem(m_entityManager, m_game, &m_spawner, m_score, m_levelPath);
-    collisionSystem.updateCollisions();
+    m_collisionSystem.updateCollisions();
+    m_playRenderer.setCollisionStats(m_collisionSystem.stats());
 }
 void Scene_Play::initializeDialogues()
 {
@@ -5304,7 +5380,7 @@ void Scene_Play::sDoAction(const Action& action)
         // std::cout << "- pausing movement" << std::endl;
         
         // Pause velocity - key states remain tracked
-        auto playerEntities = m_entityManager.getEntities("player");
+        auto playerEntities = m_entityManager.getEntities(TagId::Player);
         if (!playerEntities.empty()) {
             auto player = playerEntities[0];
             player->get<CTransform>().velocity.x = 0.f;
@@ -5329,6 +5405,14 @@ void Scene_Play::sDoAction(const Action& action)
         }
     }
     
+    // Profiler overlay, also available during dialogue
+    if (action.name() == "TOGGLE_PROFILER") {
+        if (action.type() == "START") {
+            m_showProfiler = !m_showProfiler;
+        }
+        return;
+    }
+
     // Block gameplay effects during dialogue but keep tracking key states
     if (isDialogueActive) {
         if (action.name() == "ATTACK" && action.type() == "START") {
@@ -5343,7 +5427,7 @@ void Scene_Play::sDoAction(const Action& action)
     if (!isDialogueActive && wasInDialogue) {
         // std::cout << "[DEBUG] Dialogue ended - applying current key states" << std::endl;
         
-        auto playerEntities = m_entityManager.getEntities("player");
+        auto playerEntities = m_entityManager.getEntities(TagId::Player);
         if (!playerEntities.empty()) {
             auto player = playerEntities[0];
             auto& PTrans = player->get<CTransform>();
@@ -5379,7 +5463,7 @@ void Scene_Play::sDoAction(const Action& action)
     wasInDialogue = isDialogueActive;
     
     // Normal gameplay actions
-    auto playerEntities = m_entityManager.getEntities("player");
+    auto playerEntities = m_entityManager.getEntities(TagId::Player);
     if (playerEntities.empty()) return;
 
     auto player = playerEntities[0];
@@ -5475,13 +5559,13 @@ void Scene_Play::sDoAction(const Action& action)
                 }
                 else {
                     // First, destroy any existing sword
-                    if (m_activeSword) {
-                        m_activeSword->destroy();
-                        m_activeSword = nullptr;
+                    if (auto* sword = m_entityManager.get(m_activeSword)) {
+                        sword->destroy();
                     }
+                    m_activeSword = EntityHandle();
                     
                     // Then spawn a new sword and store the reference
-                    m_activeSword = m_spawner.spawnSword(player);
+                    m_activeSword = m_spawner.spawnSword(player)->handle();
                     state.bulletCooldown = 0.5f;
                 }
             }
@@ -5627,48 +5711,46 @@ void Scene_Play::sDoAction(const Action& action)
 
 void Scene_Play::sLifespan(float deltaTime)
 {
-    for (auto e : m_entityManager.getEntities())
+    for (Entity& e : m_entityManager.view<CLifeSpan>())
     {
-        if (e->has<CLifeSpan>())
+        // Only process lifespans for specific entity types
+        if (e.tag() == TagId::EnemySword || e.tag() == TagId::EmperorSword || 
+            e.tag() == TagId::PlayerBullet || e.tag() == TagId::EnemyBullet || 
+            e.tag() == TagId::Fragment || e.tag() == TagId::Effect)
         {
-            // Only process lifespans for specific entity types
-            if (e->tag() == "enemySword" || e->tag() == "EmperorSword" || 
-                e->tag() == "playerBullet" || e->tag() == "enemyBullet" || 
-                e->tag() == "fragment" || e->tag() == "effect")
+            auto& lifespan = e.get<CLifeSpan>();
+            lifespan.remainingTime -= deltaTime;
+            
+            if (lifespan.remainingTime <= 0)
             {
-                auto& lifespan = e->get<CLifeSpan>();
-                lifespan.remainingTime -= deltaTime;
-                
-                if (lifespan.remainingTime <= 0)
-                {
-                    //std::cout << "[DEBUG] Entity '" << e->tag() << "' #" << e->id() 
-                    //          << " destroyed by lifespan system\n";
-                    e->destroy();
-                }
+                //std::cout << "[DEBUG] Entity '" << tagName(e.tag()) << "' #" << e.id() 
+                //          << " destroyed by lifespan system\n";
+                e.destroy();
             }
-            // For all other entities, we ignore their lifespan
         }
+        // For all other entities, we ignore their lifespan
     }
 }
 
 void Scene_Play::sUpdateSword()
 {
-    auto playerEntities = m_entityManager.getEntities("player");
-    if (playerEntities.empty() || !m_activeSword) return;
+    auto playerEntities = m_entityManager.getEntities(TagId::Player);
+    auto* sword = m_entityManager.get(m_activeSword);
+    if (playerEntities.empty() || !sword) return;
 
     auto player = playerEntities[0];
     auto& state = player->get<CState>();
     
     // If the attack animation is done or player state changed, destroy the sword
-    if (m_activeSword && (state.attackTime <= 0.f || state.state != "attack")) {
-        m_activeSword->destroy();
-        m_activeSword = nullptr;
+    if (state.attackTime <= 0.f || state.state != "attack") {
+        sword->destroy();
+        m_activeSword = EntityHandle();
     }
 }
 
 void Scene_Play::sAmmoSystem(float dt)
 {
-    auto playerEntities = m_entityManager.getEntities("player");
+    auto playerEntities = m_entityManager.getEntities(TagId::Player);
     if (playerEntities.empty()) return;
     
     auto player = playerEntities[0];
@@ -5707,7 +5789,7 @@ void Scene_Play::sAmmoSystem(float dt)
 void Scene_Play::updateBurstFire(float deltaTime)
 {
     // Get the player
-    auto playerEntities = m_entityManager.getEntities("player");
+    auto playerEntities = m_entityManager.getEntities(TagId::Player);
     if (playerEntities.empty()) return;
     auto player = playerEntities[0];
 
@@ -5783,7 +5865,7 @@ void Scene_Play::UpdateFragments(float deltaTime) {
 // Check for Player Death
 //
 void Scene_Play::lifeCheckPlayerDeath() {
-    auto players = m_entityManager.getEntities("player");
+    auto players = m_entityManager.getEntities(TagId::Player);
     if (players.empty()) {
         return;
     }
@@ -5797,6 +5879,11 @@ void Scene_Play::lifeCheckPlayerDeath() {
 
     if (isOutOfBounds || isDead) {
         m_gameOver = true;
+        if (m_game.isHeadless()) {
+            // No game over screen without a window: try again
+            m_game.restartLevel();
+            return;
+        }
         m_game.changeScene("GAMEOVER", std::make_shared<Scene_GameOver>(m_game));
     }
 }
@@ -5808,12 +5895,13 @@ std::string Scene_Play::extractLevelName(const std::string& path) {
 }
 
 void Scene_Play::removeTileByID(const std::string& tileID) {
-    auto tiles = m_entityManager.getEntities("tile");
+    auto tiles = m_entityManager.getEntities(TagId::Tile);
     for (auto& t : tiles) {
         if (t->has<CUniqueID>()) {
             auto& uid = t->get<CUniqueID>();
             if (uid.id == tileID) {
                 t->destroy();
+                m_tileGrid.remove(t);
                 // std::cout << "[DEBUG] Tile " << tileID << " destroyed!\n";
                 break;
             }
@@ -5821,7 +5909,7 @@ void Scene_Play::removeTileByID(const std::string& tileID) {
     }
 }
 
-void Scene_Play::handleEmperorDeath(std::shared_ptr<Entity> emperor) {
+void Scene_Play::handleEmperorDeath(Entity* emperor) {
     // Only spawn grave and destroy emperor if in Future world
     auto& enemyHealth= emperor->get<CHealth>();
 
@@ -5846,7 +5934,7 @@ void Scene_Play::handleEmperorDeath(std::shared_ptr<Entity> emperor) {
 
 
 void Scene_Play::lifeCheckEnemyDeath() {
-    auto enemies = m_entityManager.getEntities("enemy");
+    auto enemies = m_entityManager.getEntities(TagId::Enemy);
     for (auto& enemy : enemies) {
         if (!enemy->has<CHealth>()) continue;
 
@@ -5894,15 +5982,15 @@ void Scene_Play::lifeCheckEnemyDeath() {
     }
 }
 
-std::shared_ptr<Entity> Scene_Play::spawnSword(std::shared_ptr<Entity> player) {
+Entity* Scene_Play::spawnSword(Entity* player) {
     return m_spawner.spawnSword(player);
 }
 
-std::shared_ptr<Entity> Scene_Play::spawnItem(Vec2<float> position, const std::string& tileType) {
+Entity* Scene_Play::spawnItem(Vec2<float> position, const std::string& tileType) {
     return m_spawner.spawnItem(position, tileType);
 }
 
-std::shared_ptr<Entity> Scene_Play::spawnEnemySword(std::shared_ptr<Entity> enemy) {
+Entity* Scene_Play::spawnEnemySword(Entity* enemy) {
     return m_spawner.spawnEnemySword(enemy);
 }
 
@@ -5913,13 +6001,5 @@ void Scene_Play::sEnemyAI(float deltaTime) {
 bool Scene_Play::isObstacleInFront(Vec2<float> enemyPos, float direction)
 {
     Vec2<float> checkPos = enemyPos + Vec2<float>(direction * 50.f, 0.f);
-    for (auto& tile : m_entityManager.getEntities("tile")) {
-        auto& tileTrans = tile->get<CTransform>();
-        sf::FloatRect tileBB = tile->get<CBoundingBox>().getRect(tileTrans.pos);
-
-        if (tileBB.contains(checkPos.x, checkPos.y)) {
-            return true; // Obstacle detected
-        }
-    }
-    return false;
+    return m_tileGrid.tileAt(checkPos.x, checkPos.y) != nullptr; // Obstacle detected
 }
@@ -5,6 +5,7 @@
 #include "Scene_GameOver.h"
 #include "Entity.hpp"
 #include "EntityManager.hpp"
+#include "TileGrid.hpp"
 #include <string>
 #include <memory>
 #include <SFML/Graphics.hpp>
@@ -14,7 +15,9 @@
 #include "systems/MovementSystem.h"
 #include "systems/EnemyAISystem.h"
 #include "systems/Spawner.h"
+#include "systems/CollisionSystem.h"
 #include "systems/DialogueSystem.h"
+#include "systems/ParallaxBackground.h"
 
 
 class Scene_Play : public Scene {
@@ -37,18 +40,19 @@ public:
     void sAmmoSystem(float deltaTime);
     void sDoAction(const Action& action) override;
     void update(float deltaTime) override;
+    uint64_t stateHash() const override;
 
-    std::shared_ptr<Entity> m_activeSword = nullptr;
+    EntityHandle m_activeSword;   // stale once the sword dies (see EntityManager::get)
 
-    std::shared_ptr<Entity> spawnSword(std::shared_ptr<Entity> player);
-    std::shared_ptr<Entity> spawnEnemySword(std::shared_ptr<Entity> enemy);
-    std::shared_ptr<Entity> spawnItem(Vec2<float> position, const std::string& tileType);
+    Entity* spawnSword(Entity* player);
+    Entity* spawnEnemySword(Entity* enemy);
+    Entity* spawnItem(Vec2<float> position, const std::string& tileType);
 
     // Add these function declarations to your class
     void initializeDialogues();
 
 
-    void applyKnockback(std::shared_ptr<Entity> entity, Vec2<float> hitDirection, float duration);
+    void applyKnockback(Entity* entity, Vec2<float> hitDirection, float duration);
 
     // Utility functions for game logic
     bool isPathClear(Vec2<float> start, Vec2<float> end);
@@ -66,12 +70,13 @@ public:
 
     // sRender() now delegates all drawing to PlayRenderer
     void sRender() override;
+    bool drawsToFrame() const override { return true; }
 
     std::string extractLevelName(const std::string& path);
     void removeTileByID(const std::string& tileID);
     void createTile(const std::string& tileType, int gridX, int gridY);
     void updateBurstFire(float deltaTime);
-    void handleEmperorDeath(std::shared_ptr<Entity> emperor);
+    void handleEmperorDeath(Entity* emperor);
 
     // --- Configuration Constants
     const float gravityVal = 1000.f;
@@ -91,23 +96,26 @@ public:
 private:
     std::string m_levelPath;              // (1)
     EntityManager m_entityManager;        // (2)
+    TileGrid m_tileGrid;                  // (2b) static tiles of m_entityManager, built at load
     float m_lastDirection = 1.f;          // (3) 
     AnimationSystem m_animationSystem;    // (4)
     PlayRenderer m_playRenderer;          // (5)
-    sf::Texture m_backgroundTexture;      // (6)
-    sf::Sprite m_backgroundSprite;        // (7)
+    ParallaxBackground m_background;      // (6)
     GameEngine& m_game;                   // (8)
     bool m_gameOver = false;              // (9)
     LoadLevel m_levelLoader;              // (10)
     bool m_showBoundingBoxes = false;     // (11)
     bool m_showGrid = false;              // (12)
+    bool m_showProfiler = false;          // F3
     std::string m_backgroundPath;         // (13)
     std::string m_timeofday;              // (14)
     sf::View m_cameraView;                // (15)
+    sf::Vector2f m_prevCameraCenter;      // camera center at the start of the current step
     int m_score = 0;                      // (16)
     MovementSystem m_movementSystem;
     Spawner m_spawner;
     EnemyAISystem m_enemyAISystem;
+    CollisionSystem m_collisionSystem;    // long-lived: keeps its buffers and last frame's contacts
     bool m_wasDialogueActive = false;
     std::shared_ptr<DialogueSystem> m_dialogueSystem;
     std::string m_language;
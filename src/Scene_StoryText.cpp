@@ -209,6 +209,7 @@ void Scene_StoryText::renderStoryText() {
 }
 
 void Scene_StoryText::sRender() {
+    beginDraw();
     // Set black background
     m_game.window().clear(sf::Color(0, 0, 0));
     
@@ -217,8 +218,6 @@ void Scene_StoryText::sRender() {
     
     // Render story text
     renderStoryText();
-    
-    m_game.window().display();
 }
 
 void Scene_StoryText::sDoAction(const Action& action) {
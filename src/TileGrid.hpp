@@ -0,0 +1,336 @@
+#pragma once
+
+#include "EntityManager.hpp"
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <span>
+#include <SFML/Graphics.hpp>
+
+// Uniform grid over the level's tiles, one cell per LoadLevel grid square.
+// Built once at level load; a tile is registered in every cell its bounding
+// box covers, so oversized tiles (LevelDoor, BlackHoleRedBig, PipeTall...)
+// are found from any of them. Tiles don't move: their rects are cached here.
+//
+// Tiles destroyed at runtime (boxes, FutureArmor, black holes...) must be
+// remove()d; sync() rebuilds the grid if the tile group changed behind its back
+// (EntityManager::groupVersion() moved by more than the remove()s account for).
+// Other static layers (decorations) can be indexed too by passing build() the
+// rect to use for each entity.
+class TileGrid {
+public:
+    static constexpr float CELL_SIZE = 96.f;   // LoadLevel::GRID_SIZE
+    static constexpr uint32_t NPOS = std::numeric_limits<uint32_t>::max();
+
+    struct TileRecord {
+        Entity* entity = nullptr;   // nullptr once removed
+        EntityHandle handle;
+        sf::FloatRect rect;
+    };
+
+    void clear() {
+        m_records.clear();
+        m_recordOf.clear();
+        m_cells.clear();
+        m_columns = 0;
+        m_rows = 0;
+        m_liveCount = 0;
+        m_sourceVersion = 0;
+        m_built = false;
+    }
+
+    // `version` is the group's EntityManager::groupVersion()
+    void build(EntitySpan tiles, uint64_t version) {
+        build(tiles, version, boundingBoxOf);
+    }
+
+    // rectOf(entity, rect) fills the rect to index, or returns false to leave
+    // the entity out
+    template <typename RectOf>
+    void build(EntitySpan tiles, uint64_t version, RectOf&& rectOf) {
+        clear();
+        m_built = true;
+        m_sourceVersion = version;
+        if (tiles.empty()) return;
+
+        // Grid bounds from the tile rects (y can go negative on tall levels)
+        float minX = std::numeric_limits<float>::max(), minY = minX;
+        float maxX = std::numeric_limits<float>::lowest(), maxY = maxX;
+        m_records.reserve(tiles.size());
+        for (Entity* tile : tiles) {
+            TileRecord record;
+            if (!tile->isAlive() || !rectOf(tile, record.rect)) continue;
+            record.entity = tile;
+            record.handle = tile->handle();
+            minX = std::min(minX, record.rect.left);
+            minY = std::min(minY, record.rect.top);
+            maxX = std::max(maxX, record.rect.left + record.rect.width);
+            maxY = std::max(maxY, record.rect.top + record.rect.height);
+            m_records.push_back(record);
+        }
+        if (m_records.empty()) return;
+
+        m_originX = std::floor(minX / CELL_SIZE) * CELL_SIZE;
+        m_originY = std::floor(minY / CELL_SIZE) * CELL_SIZE;
+        m_columns = static_cast<int>(std::floor((maxX - m_originX) / CELL_SIZE)) + 1;
+        m_rows    = static_cast<int>(std::floor((maxY - m_originY) / CELL_SIZE)) + 1;
+        m_cells.assign(static_cast<size_t>(m_columns) * m_rows, {});
+
+        for (uint32_t i = 0; i < m_records.size(); ++i) {
+            link(i);
+        }
+        m_liveCount = m_records.size();
+    }
+
+    // Called after EntityManager::update(): tiles created or destroyed without
+    // going through this grid show up as a group version the grid doesn't
+    // expect, even when the group size is unchanged (one gone, one added).
+    void sync(EntitySpan tiles, uint64_t version) {
+        sync(tiles, version, boundingBoxOf);
+    }
+
+    template <typename RectOf>
+    void sync(EntitySpan tiles, uint64_t version, RectOf&& rectOf) {
+        if (!m_built || version != m_sourceVersion) {
+            build(tiles, version, rectOf);
+        }
+    }
+
+    void remove(Entity* tile) {
+        uint32_t index = recordOf(tile);
+        if (index == NPOS) return;
+        unlink(index);
+        m_records[index].entity = nullptr;
+        m_recordOf[tile->handle().index()] = NPOS;
+        --m_liveCount;
+        ++m_sourceVersion;   // its removal from the group, at the next EntityManager::update()
+    }
+
+    // Re-register a tile whose bounding box changed (e.g. treasure hit)
+    void refresh(Entity* tile) {
+        uint32_t index = recordOf(tile);
+        if (index == NPOS) return;
+        sf::FloatRect rect = tile->getBounds();
+        if (rect == m_records[index].rect) return;
+        unlink(index);
+        m_records[index].rect = rect;
+        link(index);
+    }
+
+    // --- Cell lookup
+    int cellX(float x) const { return static_cast<int>(std::floor((x - m_originX) / CELL_SIZE)); }
+    int cellY(float y) const { return static_cast<int>(std::floor((y - m_originY) / CELL_SIZE)); }
+    bool inBounds(int cx, int cy) const { return cx >= 0 && cy >= 0 && cx < m_columns && cy < m_rows; }
+    int columns() const { return m_columns; }
+    int rows() const { return m_rows; }
+    size_t size() const { return m_liveCount; }
+
+    // Record indices registered in a cell (empty outside the grid)
+    const std::vector<uint32_t>& cell(int cx, int cy) const {
+        static const std::vector<uint32_t> empty;
+        return inBounds(cx, cy) ? m_cells[static_cast<size_t>(cy) * m_columns + cx] : empty;
+    }
+    const TileRecord& record(uint32_t index) const { return m_records[index]; }
+    bool isLive(uint32_t index) const { return live(m_records[index]); }
+
+    // First tile whose rect contains the point
+    Entity* tileAt(float x, float y) const {
+        for (uint32_t index : cell(cellX(x), cellY(y))) {
+            const TileRecord& r = m_records[index];
+            if (live(r) && r.rect.contains(x, y)) return r.entity;
+        }
+        return nullptr;
+    }
+
+    // --- Range queries
+    // Tiles whose rect intersects `area`, in level load order (collision
+    // resolution depends on the order tiles are pushed against). Fills `out`.
+    void query(const sf::FloatRect& area, std::vector<Entity*>& out) const {
+        out.clear();
+        m_scratch.clear();
+        forEachCell(area, [&](size_t c) {
+            for (uint32_t index : m_cells[c]) {
+                if (live(m_records[index]) && m_records[index].rect.intersects(area)) {
+                    m_scratch.push_back(index);
+                }
+            }
+            return false;
+        });
+        // A tile covering several cells is found once per cell
+        std::sort(m_scratch.begin(), m_scratch.end());
+        m_scratch.erase(std::unique(m_scratch.begin(), m_scratch.end()), m_scratch.end());
+        for (uint32_t index : m_scratch) {
+            out.push_back(m_records[index].entity);
+        }
+    }
+
+    bool any(const sf::FloatRect& area) const {
+        return any(area, [&](Entity*, const sf::FloatRect& rect) { return rect.intersects(area); });
+    }
+
+    // True as soon as pred(tile, rect) holds for a tile registered in a cell
+    // overlapped by `area`. pred does its own geometry: `area` may be flat
+    // (a horizontal segment's bounds) and a tile may be tested more than once.
+    template <typename Pred>
+    bool any(const sf::FloatRect& area, Pred&& pred) const {
+        return forEachCell(area, [&](size_t c) {
+            for (uint32_t index : m_cells[c]) {
+                const TileRecord& r = m_records[index];
+                if (live(r) && pred(r.entity, r.rect)) return true;
+            }
+            return false;
+        });
+    }
+
+    // --- Raycasts
+    // True if a tile blocks the segment from -> to. Walks only the cells the
+    // segment crosses (Amanatides & Woo) and stops at the first blocking tile,
+    // so the cost depends on the segment's length, not on the level's size.
+    // Grazing a tile's edge or corner doesn't block.
+    bool raycast(const Vec2<float>& from, const Vec2<float>& to) const {
+        if (m_cells.empty()) return false;
+        const float dx = to.x - from.x;
+        const float dy = to.y - from.y;
+
+        // Clip to the grid: outside of it there are no tiles
+        float tEnter = 0.f, tExit = 1.f;
+        if (!clipSlab(from.x, dx, m_originX, m_originX + m_columns * CELL_SIZE, tEnter, tExit) ||
+            !clipSlab(from.y, dy, m_originY, m_originY + m_rows * CELL_SIZE, tEnter, tExit)) {
+            return false;
+        }
+
+        int cx = std::clamp(cellX(from.x + dx * tEnter), 0, m_columns - 1);
+        int cy = std::clamp(cellY(from.y + dy * tEnter), 0, m_rows - 1);
+        const int endX = std::clamp(cellX(from.x + dx * tExit), 0, m_columns - 1);
+        const int endY = std::clamp(cellY(from.y + dy * tExit), 0, m_rows - 1);
+
+        const int stepX = (dx > 0.f) - (dx < 0.f);
+        const int stepY = (dy > 0.f) - (dy < 0.f);
+        constexpr float INF = std::numeric_limits<float>::infinity();
+        // t (along the whole segment) of the next vertical / horizontal cell border
+        float tMaxX = stepX ? (m_originX + (cx + (stepX > 0)) * CELL_SIZE - from.x) / dx : INF;
+        float tMaxY = stepY ? (m_originY + (cy + (stepY > 0)) * CELL_SIZE - from.y) / dy : INF;
+        const float tDeltaX = stepX ? CELL_SIZE / std::abs(dx) : INF;
+        const float tDeltaY = stepY ? CELL_SIZE / std::abs(dy) : INF;
+
+        // One cell per step; bounding the count keeps float drift from running off
+        int cellsLeft = std::abs(endX - cx) + std::abs(endY - cy);
+        while (true) {
+            for (uint32_t index : m_cells[static_cast<size_t>(cy) * m_columns + cx]) {
+                const TileRecord& r = m_records[index];
+                if (live(r) && segmentCrosses(from, dx, dy, r.rect)) return true;
+            }
+            if (cellsLeft-- <= 0) return false;
+            if (tMaxX < tMaxY) {
+                cx += stepX;
+                tMaxX += tDeltaX;
+            } else {
+                cy += stepY;
+                tMaxY += tDeltaY;
+            }
+            if (!inBounds(cx, cy)) return false;
+        }
+    }
+
+    // Many origins towards one target (every enemy towards the player):
+    // visible[i] is 1 when nothing blocks origins[i] -> target
+    void lineOfSight(const Vec2<float>& target, std::span<const Vec2<float>> origins,
+                     std::vector<uint8_t>& visible) const {
+        visible.resize(origins.size());
+        for (size_t i = 0; i < origins.size(); ++i) {
+            visible[i] = raycast(origins[i], target) ? 0 : 1;
+        }
+    }
+
+private:
+    static bool boundingBoxOf(Entity* tile, sf::FloatRect& rect) {
+        if (!tile->has<CBoundingBox>()) return false;
+        rect = tile->getBounds();
+        return true;
+    }
+
+    // Liang-Barsky step: narrow [tEnter, tExit] to where p + d*t lies in [lo, hi]
+    static bool clipSlab(float p, float d, float lo, float hi, float& tEnter, float& tExit) {
+        if (d == 0.f) return p >= lo && p <= hi;
+        float a = (lo - p) / d;
+        float b = (hi - p) / d;
+        if (a > b) std::swap(a, b);
+        tEnter = std::max(tEnter, a);
+        tExit  = std::min(tExit, b);
+        return tEnter <= tExit;
+    }
+
+    // Does the segment go through the inside of rect (not just along an edge)?
+    static bool segmentCrosses(const Vec2<float>& from, float dx, float dy, const sf::FloatRect& rect) {
+        float tEnter = 0.f, tExit = 1.f;
+        if (dx == 0.f && (from.x <= rect.left || from.x >= rect.left + rect.width)) return false;
+        if (dy == 0.f && (from.y <= rect.top || from.y >= rect.top + rect.height)) return false;
+        return clipSlab(from.x, dx, rect.left, rect.left + rect.width, tEnter, tExit) &&
+               clipSlab(from.y, dy, rect.top, rect.top + rect.height, tEnter, tExit) &&
+               tEnter < tExit;
+    }
+
+    // Entity* stays readable until the manager is replaced (Scene_Play::init
+    // clears the grid then); a recycled slot carries a new generation.
+    static bool live(const TileRecord& r) {
+        return r.entity && r.entity->isAlive() && r.entity->handle() == r.handle;
+    }
+
+    uint32_t recordOf(const Entity* tile) const {
+        uint32_t slot = tile->handle().index();
+        if (slot >= m_recordOf.size()) return NPOS;
+        uint32_t index = m_recordOf[slot];
+        if (index == NPOS || m_records[index].handle != tile->handle()) return NPOS;
+        return index;
+    }
+
+    // Visit the cells overlapped by `area` (clamped to the grid), passing the
+    // row-major cell index; fn returns true to stop early
+    template <typename Fn>
+    bool forEachCell(const sf::FloatRect& area, Fn&& fn) const {
+        if (m_cells.empty()) return false;
+        int x0 = std::max(cellX(area.left), 0);
+        int y0 = std::max(cellY(area.top), 0);
+        int x1 = std::min(cellX(area.left + area.width), m_columns - 1);
+        int y1 = std::min(cellY(area.top + area.height), m_rows - 1);
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                if (fn(static_cast<size_t>(cy) * m_columns + cx)) return true;
+            }
+        }
+        return false;
+    }
+
+    void link(uint32_t index) {
+        const TileRecord& r = m_records[index];
+        uint32_t slot = r.handle.index();
+        if (slot >= m_recordOf.size()) m_recordOf.resize(slot + 1, NPOS);
+        m_recordOf[slot] = index;
+        forEachCell(r.rect, [&](size_t c) {
+            m_cells[c].push_back(index);
+            return false;
+        });
+    }
+
+    void unlink(uint32_t index) {
+        forEachCell(m_records[index].rect, [&](size_t c) {
+            auto& tiles = m_cells[c];
+            tiles.erase(std::remove(tiles.begin(), tiles.end(), index), tiles.end());
+            return false;
+        });
+    }
+
+    std::vector<TileRecord> m_records;              // one per tile, load order
+    std::vector<uint32_t> m_recordOf;               // entity slot -> record index
+    std::vector<std::vector<uint32_t>> m_cells;     // row-major, record indices
+    float m_originX = 0.f;
+    float m_originY = 0.f;
+    int m_columns = 0;
+    int m_rows = 0;
+    size_t m_liveCount = 0;
+    uint64_t m_sourceVersion = 0;                   // group version the grid matches
+    bool m_built = false;
+    mutable std::vector<uint32_t> m_scratch;        // query() dedup buffer
+};
@@ -0,0 +1,116 @@
+#include "Trace.h"
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    const char* name = nullptr;
+    int64_t start = 0;      // ns since the trace started
+    int64_t duration = 0;   // ns
+};
+
+// Written only by its thread; `written` is published with release so write()
+// sees complete events
+struct ThreadBuffer {
+    std::unique_ptr<TraceEvent[]> events{new TraceEvent[Trace::EVENTS_PER_THREAD]};
+    std::atomic<uint64_t> written{0};
+    int id = 0;
+    std::string name;
+};
+
+Trace::Clock::time_point s_origin;
+std::mutex s_registry;                                // guards s_buffers (one lock per thread, ever)
+std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;  // kept after their thread exits
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+ThreadBuffer& threadBuffer() {
+    if (!t_buffer) {
+        std::lock_guard<std::mutex> lock(s_registry);
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->id = static_cast<int>(s_buffers.size()) + 1;
+        buffer->name = "thread " + std::to_string(buffer->id);
+        t_buffer = buffer.get();
+        s_buffers.push_back(std::move(buffer));
+    }
+    return *t_buffer;
+}
+
+int64_t nanoseconds(Trace::Clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+} // namespace
+
+void Trace::start() {
+    s_origin = Clock::now();
+    s_active.store(true, std::memory_order_relaxed);
+}
+
+void Trace::setThreadName(const char* name) {
+    if (!active()) return;
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(s_registry);
+    buffer.name = name;
+}
+
+void Trace::record(const char* name, Clock::time_point start, Clock::time_point end) {
+    ThreadBuffer& buffer = threadBuffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer.events[index % EVENTS_PER_THREAD];
+    event.name = name;
+    event.start = nanoseconds(start - s_origin);
+    event.duration = nanoseconds(end - start);
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+bool Trace::write(const std::string& path) {
+    s_active.store(false, std::memory_order_relaxed);
+
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        std::cerr << "[ERROR] Failed to open trace file: " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(s_registry);
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) std::fprintf(file, ",\n");
+        first = false;
+    };
+
+    size_t dropped = 0;
+    for (const auto& buffer : s_buffers) {
+        separator();
+        std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                     buffer->id, buffer->name.c_str());
+
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t begin = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+        dropped += static_cast<size_t>(begin);
+        for (uint64_t index = begin; index < written; ++index) {
+            const TraceEvent& event = buffer->events[index % EVENTS_PER_THREAD];
+            separator();
+            std::fprintf(file, "{\"name\":\"%s\",\"cat\":\"game\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                         event.name, buffer->id, event.start / 1000.0, event.duration / 1000.0);
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+
+    bool ok = std::ferror(file) == 0;
+    std::fclose(file);
+    if (!ok) {
+        std::cerr << "[ERROR] Failed to write trace file: " << path << std::endl;
+        return false;
+    }
+    if (dropped > 0) {
+        std::cerr << "[WARNING] Trace: " << dropped << " oldest events were overwritten\n";
+    }
+    return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+// Build with -DPROFILER_ENABLED=0 and PROFILE_ZONE / PROFILE_END_FRAME /
+// TRACE_ZONE expand to nothing: no clock reads, no bookkeeping.
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Timeline of nested zones for chrome://tracing / Perfetto (main.cpp: --trace=<file>).
+// Off until start(). Each thread records into its own ring of
+// EVENTS_PER_THREAD events (the oldest are overwritten), with no lock and no
+// allocation after its first event. write() dumps every ring as Chrome
+// trace-event JSON; call it once the other threads have stopped.
+//
+// Zone names must be string literals (only the pointer is stored).
+class Trace {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t EVENTS_PER_THREAD = size_t(1) << 18;   // 6 MB, minutes of play
+
+    static void start();
+    static bool active() { return s_active.load(std::memory_order_relaxed); }
+    // Label of the calling thread in the viewer
+    static void setThreadName(const char* name);
+
+    static void record(const char* name, Clock::time_point start, Clock::time_point end);
+
+    // Stops recording. Returns false if the file can't be written.
+    static bool write(const std::string& path);
+
+private:
+    static inline std::atomic<bool> s_active{false};
+};
+
+// Records its scope as one complete event, if tracing is on
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) {
+        if (Trace::active()) {
+            m_name = name;
+            m_start = Trace::Clock::now();
+        }
+    }
+    ~TraceScope() {
+        if (m_name) Trace::record(m_name, m_start, Trace::Clock::now());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name = nullptr;
+    Trace::Clock::time_point m_start;
+};
+
+#if PROFILER_ENABLED
+#define TRACE_ZONE(name) TraceScope PROFILE_CONCAT(traceScope_, __LINE__)(name)
+#else
+#define TRACE_ZONE(name) ((void)0)
+#endif
@@ -11,7 +11,7 @@ AnimationSystem::AnimationSystem(GameEngine& game, EntityManager& entityManager,
 
 void AnimationSystem::update(float deltaTime) {
     // --- Player Animation ---
-    for (auto& entity : m_entityManager.getEntities("player")) {
+    for (auto& entity : m_entityManager.getEntities(TagId::Player)) {
         if (!entity->has<CAnimation>() || !entity->has<CState>()) continue;
     
         auto& canim = entity->get<CAnimation>();
@@ -94,45 +94,33 @@ void AnimationSystem::update(float deltaTime) {
         canim.animation.update(deltaTime);
     }
 
-    // --- Tile Animation (e.g., Question Blocks) ---
-    for (auto& entity : m_entityManager.getEntities("tile")) {
-        if (!entity->has<CAnimation>()) continue;
-
-        auto& anim  = entity->get<CAnimation>();
-        auto& state = entity->get<CState>();
-
-        if (state.state == "activated" && anim.animation.getName() == "TreasureBoxAnim") {
-            if (m_game.assets().hasAnimation("TexTreasureBoxHit")) {
-                anim.animation = m_game.assets().getAnimation("TexTreasureBoxHit");
-                anim.repeat = false;
-            }
+    // --- Tiles, graves, collectables and decorations ---
+    // One pass down the CAnimation pool instead of four tag groups
+    m_entityManager.each<CAnimation>([&](Entity& entity, CAnimation& anim) {
+        switch (entity.tag()) {
+            case TagId::Tile:
+                // Only treasure boxes carry a CState
+                if (entity.has<CState>() && entity.get<CState>().state == "activated" &&
+                    anim.animation.getName() == "TreasureBoxAnim") {
+                    if (m_game.assets().hasAnimation("TexTreasureBoxHit")) {
+                        anim.animation = m_game.assets().getAnimation("TexTreasureBoxHit");
+                        anim.repeat = false;
+                    }
+                }
+                anim.animation.update(deltaTime);
+                break;
+            case TagId::EnemyGrave:
+            case TagId::Collectable:
+            case TagId::Decoration:
+                anim.animation.update(deltaTime);
+                break;
+            default:
+                break;
         }
-        anim.animation.update(deltaTime);
-    }
-
-    for (auto& grave : m_entityManager.getEntities("enemyGrave")) {
-        if (!grave->has<CAnimation>()) continue;
-        grave->get<CAnimation>().animation.update(deltaTime);
-    }
-
-    // --- Collectable Animation (e.g., Coins, Items) ---
-    for (auto& entity : m_entityManager.getEntities("collectable")) {
-        if (!entity->has<CAnimation>()) continue;
-
-        auto& anim = entity->get<CAnimation>();
-        anim.animation.update(deltaTime);
-    }
-
-    // --- Dec Animation ---
-    for (auto& entity : m_entityManager.getEntities("decoration")) {
-        if (!entity->has<CAnimation>()) continue;
-
-        auto& anim = entity->get<CAnimation>();
-        anim.animation.update(deltaTime);
-    }
+    });
 
     // --- Enemy Animation ---
-    for (auto& enemy : m_entityManager.getEntities("enemy")) {
+    for (auto& enemy : m_entityManager.getEntities(TagId::Enemy)) {
         if (!enemy->has<CAnimation>() || !enemy->has<CEnemyAI>()) continue;
     
         auto& canim = enemy->get<CAnimation>();
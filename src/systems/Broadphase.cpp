@@ -0,0 +1,92 @@
+#include "Broadphase.h"
+#include <algorithm>
+#include <iostream>
+
+Broadphase::Broadphase() {
+    m_bucketOf.fill(NO_BUCKET);
+}
+
+void Broadphase::track(TagId first, TagId second) {
+    if (bucketOf(first, second) != NO_BUCKET) return;
+    if (bucketOf(second, first) != NO_BUCKET) {
+        std::cerr << "[WARNING] Broadphase: pair " << tagName(second) << "/" << tagName(first)
+                  << " already tracked the other way round\n";
+        return;
+    }
+    bucketOf(first, second) = static_cast<int16_t>(m_buckets.size());
+    m_buckets.emplace_back();
+    m_trackedTag[static_cast<size_t>(first)]  = true;
+    m_trackedTag[static_cast<size_t>(second)] = true;
+}
+
+const std::vector<Broadphase::CandidatePair>& Broadphase::pairs(TagId first, TagId second) const {
+    static const std::vector<CandidatePair> none;
+    int16_t bucket = bucketOf(first, second);
+    if (bucket == NO_BUCKET) {
+        std::cerr << "[ERROR] Broadphase: pair " << tagName(first) << "/" << tagName(second)
+                  << " is not tracked\n";
+        return none;
+    }
+    return m_buckets[bucket];
+}
+
+void Broadphase::addPair(const Proxy& a, const Proxy& b, CollisionStats& stats) {
+    int16_t bucket = bucketOf(a.tag, b.tag);
+    bool swapped = false;
+    if (bucket == NO_BUCKET) {
+        bucket = bucketOf(b.tag, a.tag);
+        swapped = true;
+    }
+    if (bucket == NO_BUCKET) return;
+
+    const Proxy* first  = swapped ? &b : &a;
+    const Proxy* second = swapped ? &a : &b;
+    // Same-tag pairs keep the (i < j) order of the old nested loop
+    if (a.tag == b.tag && first->order > second->order) {
+        std::swap(first, second);
+    }
+    m_buckets[bucket].push_back({first->entity, second->entity, first->order, second->order});
+    ++stats.candidatePairs;
+}
+
+void Broadphase::update(EntityManager& entityManager, CollisionStats& stats) {
+    m_proxies.clear();
+    for (auto& bucket : m_buckets) {
+        bucket.clear();
+    }
+
+    for (size_t t = 0; t < TAG_COUNT; ++t) {
+        if (!m_trackedTag[t]) continue;
+        TagId tag = static_cast<TagId>(t);
+        auto group = entityManager.getEntities(tag);
+        for (size_t i = 0; i < group.size(); ++i) {
+            Entity* entity = group[i];
+            if (!entity->has<CTransform>() || !entity->has<CBoundingBox>()) continue;
+            sf::FloatRect rect = entity->getBounds();
+            m_proxies.push_back({rect.left - MARGIN, rect.left + rect.width + MARGIN,
+                                 rect.top - MARGIN,  rect.top + rect.height + MARGIN,
+                                 entity, tag, static_cast<uint32_t>(i)});
+        }
+    }
+    stats.proxies += m_proxies.size();
+
+    std::sort(m_proxies.begin(), m_proxies.end(),
+              [](const Proxy& a, const Proxy& b) { return a.minX < b.minX; });
+
+    for (size_t i = 0; i < m_proxies.size(); ++i) {
+        const Proxy& a = m_proxies[i];
+        for (size_t j = i + 1; j < m_proxies.size(); ++j) {
+            const Proxy& b = m_proxies[j];
+            if (b.minX >= a.maxX) break;   // sorted: nothing further right can overlap a
+            if (b.minY >= a.maxY || a.minY >= b.maxY) continue;
+            addPair(a, b, stats);
+        }
+    }
+
+    for (auto& bucket : m_buckets) {
+        std::sort(bucket.begin(), bucket.end(), [](const CandidatePair& a, const CandidatePair& b) {
+            return a.firstOrder != b.firstOrder ? a.firstOrder < b.firstOrder
+                                                : a.secondOrder < b.secondOrder;
+        });
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "EntityManager.hpp"
+#include <array>
+#include <vector>
+#include <cstdint>
+
+// Per-frame collision counters (drawn with the bounding boxes, key B)
+struct CollisionStats {
+    size_t proxies = 0;            // moving entities fed to the broadphase
+    size_t candidatePairs = 0;     // tracked pairs whose boxes overlap
+    size_t narrowphaseTests = 0;   // rectangle tests done by the handlers
+    size_t contacts = 0;           // pairs that really overlap
+    size_t newContacts = 0;        // ...and didn't last frame
+};
+
+// Sort-and-sweep on x over the moving entities. Levels are wide and flat, so
+// once the boxes are sorted by left edge each one is only compared with the
+// few that start before it ends.
+// Only the tag pairs registered with track() produce pairs. A bucket is ordered
+// like the nested group loops it replaces: first tag's group order, then second's.
+class Broadphase {
+public:
+    // Boxes are grown by this much: handlers still move bodies around after
+    // the sweep (tile resolution, pushes) and re-test the exact rects.
+    static constexpr float MARGIN = 16.f;
+
+    struct CandidatePair {
+        Entity* first;
+        Entity* second;
+        uint32_t firstOrder;    // index in the first tag's group
+        uint32_t secondOrder;
+    };
+
+    Broadphase();
+
+    void track(TagId first, TagId second);
+    void update(EntityManager& entityManager, CollisionStats& stats);
+
+    // Pairs for a tracked (first, second), `first` from the first tag
+    const std::vector<CandidatePair>& pairs(TagId first, TagId second) const;
+
+private:
+    struct Proxy {
+        float minX, maxX, minY, maxY;
+        Entity* entity;
+        TagId tag;
+        uint32_t order;
+    };
+
+    static constexpr int16_t NO_BUCKET = -1;
+
+    int16_t& bucketOf(TagId first, TagId second) {
+        return m_bucketOf[static_cast<size_t>(first) * TAG_COUNT + static_cast<size_t>(second)];
+    }
+    int16_t bucketOf(TagId first, TagId second) const {
+        return m_bucketOf[static_cast<size_t>(first) * TAG_COUNT + static_cast<size_t>(second)];
+    }
+    void addPair(const Proxy& a, const Proxy& b, CollisionStats& stats);
+
+    std::array<int16_t, TAG_COUNT * TAG_COUNT> m_bucketOf;
+    std::array<bool, TAG_COUNT> m_trackedTag{};
+    std::vector<std::vector<CandidatePair>> m_buckets;
+    std::vector<Proxy> m_proxies;
+};
@@ -5,19 +5,157 @@
 #include <algorithm>
 #include <limits>
 #include <random>
+#include <charconv>
 #include <SFML/Graphics.hpp>
 
-CollisionSystem::CollisionSystem(EntityManager& entityManager, GameEngine& game, Spawner* spawner, int& score, const std::string& levelPath)
-    : m_entityManager(entityManager), m_game(game), m_spawner(spawner), m_score(score), m_levelPath(levelPath) {}
+CollisionSystem::CollisionSystem(EntityManager& entityManager, TileGrid& tileGrid, GameEngine& game, Spawner* spawner, int& score, const std::string& levelPath)
+    : m_entityManager(entityManager), m_tileGrid(tileGrid), m_game(game), m_spawner(spawner), m_score(score), m_levelPath(levelPath),
+      m_isEmperorRoom(levelPath.find("future_rome_level_4_emperor_room") != std::string::npos)
+{
+    // Tag pairs the handlers below ask the broadphase for (first = outer loop)
+    m_broadphase.track(TagId::Enemy,                   TagId::Player);
+    m_broadphase.track(TagId::Enemy,                   TagId::Enemy);
+    m_broadphase.track(TagId::Sword,                   TagId::Enemy);
+    m_broadphase.track(TagId::EnemySword,              TagId::Player);
+    m_broadphase.track(TagId::EnemySword,              TagId::Enemy);
+    m_broadphase.track(TagId::EmperorSword,            TagId::Player);
+    m_broadphase.track(TagId::EmperorSwordArmor,       TagId::Player);
+    m_broadphase.track(TagId::EmperorSwordRadial,      TagId::Player);
+    m_broadphase.track(TagId::PlayerBullet,            TagId::Enemy);
+    m_broadphase.track(TagId::EnemyBullet,             TagId::Enemy);
+    m_broadphase.track(TagId::EnemyBullet,             TagId::Player);
+    m_broadphase.track(TagId::EmperorBlackHole,        TagId::Player);
+    m_broadphase.track(TagId::EmperorMassiveBlackHole, TagId::Player);
+    m_broadphase.track(TagId::Player,                  TagId::Collectable);
+
+    // Scratch memory sized for a busy frame, so steady state never grows it
+    m_tileHits.reserve(SCRATCH_RESERVE);
+    m_enemiesById.reserve(SCRATCH_RESERVE);
+    m_contacts.reserve(SCRATCH_RESERVE);
+    m_lastContacts.reserve(SCRATCH_RESERVE);
+    m_groundContacts.reserve(SCRATCH_RESERVE);
+    m_lastGroundContacts.reserve(SCRATCH_RESERVE);
+}
+
+// Forget everything kept from the previous frame (the entity manager was reset)
+void CollisionSystem::reset() {
+    m_contacts.clear();
+    m_lastContacts.clear();
+    m_groundContacts.clear();
+    m_lastGroundContacts.clear();
+    m_stats = CollisionStats();
+}
+
+// World-specific tile names, rebuilt only when the world changes
+void CollisionSystem::refreshTileNames() {
+    if (m_tileNames.world == m_game.worldType && !m_tileNames.world.empty())
+        return;
+    const std::string& world = m_game.worldType;
+    m_tileNames.world         = world;
+    m_tileNames.levelDoor     = world + "LevelDoor";
+    m_tileNames.levelDoorGold = world + "LevelDoorGold";
+    m_tileNames.blackHoleBig  = world + "BlackHoleRedBig";
+    m_tileNames.box1          = world + "Box1";
+    m_tileNames.box2          = world + "Box2";
+    m_tileNames.treasure      = world + "Treasure";
+    m_tileNames.treasureHit   = world + "TreasureHit";
+}
+
+// Tiles overlapping `area` grown by `margin` on every side, in level order.
+// The result is a member buffer: don't call tilesIn() again while iterating it.
+const std::vector<Entity*>& CollisionSystem::tilesIn(const sf::FloatRect& area, float margin) {
+    sf::FloatRect grown(area.left - margin, area.top - margin,
+                        area.width + 2.f * margin, area.height + 2.f * margin);
+    m_tileGrid.query(grown, m_tileHits);
+    return m_tileHits;
+}
+
+void CollisionSystem::destroyTile(Entity* tile) {
+    tile->destroy();
+    m_tileGrid.remove(tile);
+}
+
+// Enemy that fired a bullet or swung a sword: its CState.state holds the enemy id
+Entity* CollisionSystem::findEnemy(const std::string& idText) const {
+    size_t id = 0;
+    auto [end, error] = std::from_chars(idText.data(), idText.data() + idText.size(), id);
+    if (error != std::errc() || end != idText.data() + idText.size())
+        return nullptr;
+
+    auto it = std::lower_bound(m_enemiesById.begin(), m_enemiesById.end(), id,
+                               [](const Entity* enemy, size_t value) { return enemy->id() < value; });
+    return (it != m_enemiesById.end() && (*it)->id() == id) ? *it : nullptr;
+}
+
+// Exact test on a broadphase pair; a hit is kept as this frame's contact
+bool CollisionSystem::overlaps(const Broadphase::CandidatePair& pair, const sf::FloatRect& a, const sf::FloatRect& b) {
+    ++m_stats.narrowphaseTests;
+    if (!a.intersects(b))
+        return false;
+    uint64_t key = contactKey(pair.first, pair.second);
+    m_contacts.push_back(key);
+    ++m_stats.contacts;
+    if (!std::binary_search(m_lastContacts.begin(), m_lastContacts.end(), key)) {
+        ++m_stats.newContacts;
+    }
+    return true;
+}
+
+// True if a and b overlapped last frame too (false on the first frame of a hit)
+bool CollisionSystem::touchedLastFrame(const Entity* a, const Entity* b) const {
+    return std::binary_search(m_lastContacts.begin(), m_lastContacts.end(), contactKey(a, b));
+}
+
+// Warm start: put the tile the body stood on last frame first in m_tileHits.
+// Resolving the floor first lifts the body out of it, so the seam of the next
+// floor tile doesn't register as a wall.
+void CollisionSystem::warmStartGround(const Entity* body) {
+    auto last = std::lower_bound(m_lastGroundContacts.begin(), m_lastGroundContacts.end(), body->handle(),
+                                 [](const GroundContact& c, EntityHandle h) { return c.body.value < h.value; });
+    if (last == m_lastGroundContacts.end() || last->body != body->handle())
+        return;
+    auto it = std::find_if(m_tileHits.begin(), m_tileHits.end(),
+                           [&](const Entity* tile) { return tile->handle() == last->tile; });
+    if (it != m_tileHits.end()) {
+        std::rotate(m_tileHits.begin(), it, it + 1);
+    }
+}
+
+void CollisionSystem::recordGround(const Entity* body, const Entity* tile) {
+    m_groundContacts.push_back({body->handle(), tile->handle()});
+}
+
+bool CollisionSystem::isSuper2(Entity* bullet) const {
+    if (!bullet->has<CState>())
+        return false;
+    Entity* enemy = findEnemy(bullet->get<CState>().state);
+    return enemy && enemy->has<CEnemyAI>() && enemy->get<CEnemyAI>().enemyType == EnemyType::Super2;
+}
 
 void CollisionSystem::updateCollisions() {
     if (m_score >=100) {
-        for (auto& player : m_entityManager.getEntities("player")) {
+        for (auto& player : m_entityManager.getEntities(TagId::Player)) {
             auto& health = player->get<CHealth>();
             health.heal(health.maxHealth);
         m_score -=100;
         }
     }
+    refreshTileNames();
+
+    // Last frame's contacts become the lookup set; buffers keep their capacity
+    std::swap(m_contacts, m_lastContacts);
+    m_contacts.clear();
+    std::swap(m_groundContacts, m_lastGroundContacts);
+    m_groundContacts.clear();
+
+    m_stats = CollisionStats();
+    m_broadphase.update(m_entityManager, m_stats);
+
+    auto enemies = m_entityManager.getEntities(TagId::Enemy);
+    m_enemiesById.assign(enemies.begin(), enemies.end());
+    std::sort(m_enemiesById.begin(), m_enemiesById.end(),
+              [](const Entity* a, const Entity* b) { return a->id() < b->id(); });
+
     handlePlayerTileCollisions();
     handleEnemyTileCollisions();
     handlePlayerEnemyCollisions();
@@ -28,11 +166,16 @@ void CollisionSystem::updateCollisions() {
     handleBulletPlayerCollisions();
     handlePlayerBulletCollisions();
     handlePlayerCollectibleCollisions();
+
+    // Sorted for the binary searches of next frame
+    std::sort(m_contacts.begin(), m_contacts.end());
+    std::sort(m_groundContacts.begin(), m_groundContacts.end(),
+              [](const GroundContact& a, const GroundContact& b) { return a.body.value < b.body.value; });
 }
 
 // Player - Tile
 void CollisionSystem::handlePlayerTileCollisions() {
-    for (auto& player : m_entityManager.getEntities("player")) {
+    for (auto& player : m_entityManager.getEntities(TagId::Player)) {
 
         if (!player->has<CTransform>() || !player->has<CBoundingBox>() || !player->has<CState>())
             continue;
@@ -50,10 +193,12 @@ void CollisionSystem::handlePlayerTileCollisions() {
         // Store if we picked up armor 
         [[maybe_unused]]bool pickedUpArmor = false;
 
-        std::shared_ptr<Entity> tileToDestroy = nullptr;
+        Entity* tileToDestroy = nullptr;
 
         // Check collision with each tile
-        for (auto& tile : m_entityManager.getEntities("tile")) {
+        tilesIn(pRect, TILE_QUERY_MARGIN);
+        warmStartGround(player);
+        for (auto& tile : m_tileHits) {
             if (!tile->has<CTransform>() || !tile->has<CBoundingBox>() || !tile->has<CAnimation>())
                 continue;
 
@@ -67,7 +212,7 @@ void CollisionSystem::handlePlayerTileCollisions() {
             if (!pRect.intersects(tRect))
                 continue;
 
-            std::string animName = tileAnim.getName();
+            const std::string& animName = tileAnim.getName();
             if (animName == "AlienBlackHoleAttack") {
                 if (player->has<CHealth>()) {
                     auto& health = player->get<CHealth>();
@@ -83,12 +228,8 @@ void CollisionSystem::handlePlayerTileCollisions() {
             // Potential next-level logic
             std::string nextLevelPath = "";
 
-            std::string worldLevelDoor       = m_game.worldType + "LevelDoor";  
-            std::string worldLevelDoorGold   = m_game.worldType + "LevelDoorGold";
-            std::string worldLevelBlackHole  = m_game.worldType + "BlackHoleRedBig";
-
             // If tile is a LevelDoor/BlackHole
-            if (animName == worldLevelDoor || animName == worldLevelDoorGold || animName == worldLevelBlackHole) {
+            if (animName == m_tileNames.levelDoor || animName == m_tileNames.levelDoorGold || animName == m_tileNames.blackHoleBig) {
                 m_game.scheduleLevelChange(m_game.getNextLevelPath());
                 return;
             }
@@ -145,6 +286,7 @@ void CollisionSystem::handlePlayerTileCollisions() {
                     transform.pos.y -= overlapY;
                     velocity.y = 0.f;
                     state.onGround = true; // Landed on tile
+                    recordGround(player, tile);
                 } else {
                     // Player hit the tile from below
                     if (velocity.y < 0) {
@@ -152,23 +294,24 @@ void CollisionSystem::handlePlayerTileCollisions() {
                         velocity.y = 0.f;
 
                         // Example: breakable or special tiles
-                        if (animName == m_game.worldType + "Box1" ||
-                            animName == m_game.worldType + "Box2")
+                        if (animName == m_tileNames.box1 ||
+                            animName == m_tileNames.box2)
                         {
                             m_spawner->createBlockFragments(tileTransform.pos, animName);
                             m_spawner->spawnItem(tileTransform.pos, animName);
                             tileToDestroy = tile;
                             // std::cout << "[DEBUG] " << animName << " broken from below!\n";
                         } 
-                        else if (animName == m_game.worldType + "Treasure") {
+                        else if (animName == m_tileNames.treasure) {
                             auto& tileState = tile->get<CState>();
                             if (tileState.state == "inactive") {
                                 tileState.state = "activated";
-                                std::string treasureHitAnim = m_game.worldType + "TreasureHit";
+                                const std::string& treasureHitAnim = m_tileNames.treasureHit;
 
                                 if (m_game.assets().hasAnimation(treasureHitAnim)) {
                                     tile->get<CAnimation>().animation = m_game.assets().getAnimation(treasureHitAnim);
                                     tile->get<CAnimation>().repeat = false;
+                                    m_tileGrid.refresh(tile);
                                     // std::cout << "[DEBUG] " << animName << " hit from below.\n";
                                 }
                                 m_spawner->spawnItem(tileTransform.pos, treasureHitAnim);
@@ -184,7 +327,7 @@ void CollisionSystem::handlePlayerTileCollisions() {
 
         // AFTER checking all tiles, destroy any tile we flagged
         if (tileToDestroy) {
-            tileToDestroy->destroy();
+            destroyTile(tileToDestroy);
         }
 
         // Update player state if not attacking
@@ -200,7 +343,7 @@ void CollisionSystem::handlePlayerTileCollisions() {
 }
 
 void CollisionSystem::handleMassiveBlackHoleCollisions() {
-    for (auto& massiveBlackHole : m_entityManager.getEntities("emperorMassiveBlackHole")) {
+    for (auto& massiveBlackHole : m_entityManager.getEntities(TagId::EmperorMassiveBlackHole)) {
         if (!massiveBlackHole->has<CTransform>() || !massiveBlackHole->has<CBoundingBox>()) 
             continue;
 
@@ -209,7 +352,7 @@ void CollisionSystem::handleMassiveBlackHoleCollisions() {
         sf::FloatRect blackHoleRect = blackHoleBB.getRect(blackHoleTrans.pos);
 
         // destroy ALL tiles it passes through
-        for (auto& tile : m_entityManager.getEntities("tile")) {
+        for (auto& tile : tilesIn(blackHoleRect)) {
             if (!tile->has<CTransform>() || !tile->has<CBoundingBox>())
                 continue;
 
@@ -220,33 +363,29 @@ void CollisionSystem::handleMassiveBlackHoleCollisions() {
             // Using regular collision for simplicity
             if (blackHoleRect.intersects(tileRect)) {
                 auto& tileAnim      = tile->get<CAnimation>().animation;
-                std::string animName = tileAnim.getName();
+                const std::string& animName = tileAnim.getName();
                 m_spawner->createBlockFragments(tileTrans.pos, animName);
-                tile->destroy();
+                destroyTile(tile);
             }
         }
-        
-        // Instant death on player contact
-        for (auto& player : m_entityManager.getEntities("player")) {
-            if (!player->has<CTransform>() || !player->has<CBoundingBox>())
-                continue;
+    }
 
-            auto& playerTrans = player->get<CTransform>();
-            auto& playerBB = player->get<CBoundingBox>();
-            sf::FloatRect playerRect = playerBB.getRect(playerTrans.pos);
+    // Instant death on player contact
+    for (auto& pair : m_broadphase.pairs(TagId::EmperorMassiveBlackHole, TagId::Player)) {
+        Entity* massiveBlackHole = pair.first;
+        Entity* player           = pair.second;
 
-            if (blackHoleRect.intersects(playerRect)) {
-                // Instant kill
-                if (player->has<CHealth>()) {
-                    player->get<CHealth>().currentHealth = 0;
-                }
+        if (overlaps(pair, massiveBlackHole->getBounds(), player->getBounds())) {
+            // Instant kill
+            if (player->has<CHealth>()) {
+                player->get<CHealth>().currentHealth = 0;
             }
         }
     }
 }
 
 void CollisionSystem::handleEnemyTileCollisions() {
-    for (auto& enemy : m_entityManager.getEntities("enemy")) {
+    for (auto& enemy : m_entityManager.getEntities(TagId::Enemy)) {
         if (!enemy->has<CTransform>() || !enemy->has<CBoundingBox>()) continue;
 
         auto& transform = enemy->get<CTransform>();
@@ -268,7 +407,9 @@ void CollisionSystem::handleEnemyTileCollisions() {
         // Detect if an EnemySuper has a tile in front
         bool tileInFront = false;
 
-        for (auto& tile : m_entityManager.getEntities("tile")) {
+        tilesIn(eRect, TILE_QUERY_MARGIN);
+        warmStartGround(enemy);
+        for (auto& tile : m_tileHits) {
             if (!tile->has<CTransform>() || !tile->has<CBoundingBox>() || !tile->has<CAnimation>()) continue;
 
             auto& tileTrans = tile->get<CTransform>();
@@ -279,7 +420,7 @@ void CollisionSystem::handleEnemyTileCollisions() {
             // Skip if no intersection
             if (!eRect.intersects(tRect)) continue;
 
-            std::string animName = tileAnim.getName();
+            const std::string& animName = tileAnim.getName();
 
             // If tile is a black hole and enemy is a citizen, kill the citizen
             if (animName.find("BlackHole") != std::string::npos) {
@@ -336,6 +477,7 @@ void CollisionSystem::handleEnemyTileCollisions() {
                     transform.pos.y -= overlapY;
                     velocity.y = 0.f;
                     onGround = true;
+                    recordGround(enemy, tile);
                 } else {
                     transform.pos.y += overlapY;
                     velocity.y = 0.f;
@@ -360,82 +502,71 @@ void CollisionSystem::handleEnemyTileCollisions() {
 
 void CollisionSystem::handleEnemyEnemyCollisions() {
 
-    auto enemies = m_entityManager.getEntities("enemy");
+    // Broadphase pairs come as (i < j), so we don't repeat or compare an enemy with itself
+    for (auto& pair : m_broadphase.pairs(TagId::Enemy, TagId::Enemy)) {
+        Entity* e1 = pair.first;
+        Entity* e2 = pair.second;
 
-    // Compare every pair of enemies (i < j) so we don't repeat or compare an enemy with itself
-    for (size_t i = 0; i < enemies.size(); i++) {
-        for (size_t j = i + 1; j < enemies.size(); j++) {
-            auto e1 = enemies[i];
-            auto e2 = enemies[j];
+        auto& t1 = e1->get<CTransform>();
+        auto& bb1 = e1->get<CBoundingBox>();
+        sf::FloatRect r1 = bb1.getRect(t1.pos);
 
-            // Ensure both have transforms and bounding boxes
-            if (!e1->has<CTransform>() || !e1->has<CBoundingBox>())
-                continue;
-            if (!e2->has<CTransform>() || !e2->has<CBoundingBox>())
-                continue;
-
-            auto& t1 = e1->get<CTransform>();
-            auto& bb1 = e1->get<CBoundingBox>();
-            sf::FloatRect r1 = bb1.getRect(t1.pos);
+        auto& t2 = e2->get<CTransform>();
+        auto& bb2 = e2->get<CBoundingBox>();
+        sf::FloatRect r2 = bb2.getRect(t2.pos);
 
-            auto& t2 = e2->get<CTransform>();
-            auto& bb2 = e2->get<CBoundingBox>();
-            sf::FloatRect r2 = bb2.getRect(t2.pos);
-
-            // Check intersection
-            if (!r1.intersects(r2))
-                continue;
-
-            // Calculate overlap on X and Y
-            float overlapX = std::min(r1.left + r1.width,  r2.left + r2.width)
-                           - std::max(r1.left,            r2.left);
-            float overlapY = std::min(r1.top + r1.height, r2.top + r2.height)
-                           - std::max(r1.top,             r2.top);
-
-            // Decide which axis to resolve based on smaller overlap
-            if (overlapX < overlapY) {
-                // --- Resolve horizontally ---
-                // We'll push each enemy half the overlap
-                float push = overlapX * 0.5f;
-
-                // If e1 is left of e2
-                if (t1.pos.x < t2.pos.x) {
-                    t1.pos.x -= push;
-                    t2.pos.x += push;
-                } else {
-                    t1.pos.x += push;
-                    t2.pos.x -= push;
-                }
+        // Check intersection
+        if (!overlaps(pair, r1, r2))
+            continue;
 
-                // Optionally zero out their horizontal velocities so they stop sliding into each other
-                if (std::abs(t1.velocity.x) > 0.f) t1.velocity.x = 0.f;
-                if (std::abs(t2.velocity.x) > 0.f) t2.velocity.x = 0.f;
+        // Calculate overlap on X and Y
+        float overlapX = std::min(r1.left + r1.width,  r2.left + r2.width)
+                       - std::max(r1.left,            r2.left);
+        float overlapY = std::min(r1.top + r1.height, r2.top + r2.height)
+                       - std::max(r1.top,             r2.top);
+
+        // Decide which axis to resolve based on smaller overlap
+        if (overlapX < overlapY) {
+            // --- Resolve horizontally ---
+            // We'll push each enemy half the overlap
+            float push = overlapX * 0.5f;
+
+            // If e1 is left of e2
+            if (t1.pos.x < t2.pos.x) {
+                t1.pos.x -= push;
+                t2.pos.x += push;
+            } else {
+                t1.pos.x += push;
+                t2.pos.x -= push;
             }
-            else {
-                // --- Resolve vertically ---
-                float push = overlapY * 0.5f;
-
-                // If e1 is above e2
-                if (t1.pos.y < t2.pos.y) {
-                    t1.pos.y -= push;
-                    t2.pos.y += push;
-                } else {
-                    t1.pos.y += push;
-                    t2.pos.y -= push;
-                }
 
-                // Optionally zero out their vertical velocities
-                if (std::abs(t1.velocity.y) > 0.f) t1.velocity.y = 0.f;
-                if (std::abs(t2.velocity.y) > 0.f) t2.velocity.y = 0.f;
+            // Optionally zero out their horizontal velocities so they stop sliding into each other
+            if (std::abs(t1.velocity.x) > 0.f) t1.velocity.x = 0.f;
+            if (std::abs(t2.velocity.x) > 0.f) t2.velocity.x = 0.f;
+        }
+        else {
+            // --- Resolve vertically ---
+            float push = overlapY * 0.5f;
+
+            // If e1 is above e2
+            if (t1.pos.y < t2.pos.y) {
+                t1.pos.y -= push;
+                t2.pos.y += push;
+            } else {
+                t1.pos.y += push;
+                t2.pos.y -= push;
             }
+
+            // Optionally zero out their vertical velocities
+            if (std::abs(t1.velocity.y) > 0.f) t1.velocity.y = 0.f;
+            if (std::abs(t2.velocity.y) > 0.f) t2.velocity.y = 0.f;
         }
     }
 }
 void CollisionSystem::handlePlayerEnemyCollisions() {
-    for (auto& enemy : m_entityManager.getEntities("enemy")) {
-        // Skip if missing required components
-        if (!enemy->has<CTransform>() || !enemy->has<CBoundingBox>())
-            continue;
+    for (auto& pair : m_broadphase.pairs(TagId::Enemy, TagId::Player)) {
+        Entity* enemy  = pair.first;
+        Entity* player = pair.second;
 
         // Skip enemy if in attack state
         if (enemy->has<CEnemyAI>()) {
@@ -450,69 +581,67 @@ void CollisionSystem::handlePlayerEnemyCollisions() {
         auto& enemyBB    = enemy->get<CBoundingBox>();
         sf::FloatRect enemyRect = enemyBB.getRect(enemyTrans.pos);
 
-        for (auto& player : m_entityManager.getEntities("player")) {
-            if (!player->has<CTransform>() || !player->has<CBoundingBox>() || !player->has<CState>())
-                continue;
-                
-            auto& pTrans = player->get<CTransform>();
-            auto& pBB    = player->get<CBoundingBox>();
-            auto& pState = player->get<CState>();
-            sf::FloatRect playerRect = pBB.getRect(pTrans.pos);
+        if (!player->has<CState>())
+            continue;
+            
+        auto& pTrans = player->get<CTransform>();
+        auto& pBB    = player->get<CBoundingBox>();
+        auto& pState = player->get<CState>();
+        sf::FloatRect playerRect = pBB.getRect(pTrans.pos);
+        
+        if (overlaps(pair, enemyRect, playerRect)) {
+            // Compute overlaps along X and Y
+            float overlapX = std::min(enemyRect.left + enemyRect.width, playerRect.left + playerRect.width)
+                             - std::max(enemyRect.left, playerRect.left);
+            float overlapY = std::min(enemyRect.top + enemyRect.height, playerRect.top + playerRect.height)
+                             - std::max(enemyRect.top, playerRect.top);
+
+            const float MIN_VERTICAL_SEPARATION = 5.f;
+            float separation = std::max(overlapY * COLLISION_SEPARATION_FACTOR, MIN_VERTICAL_SEPARATION);
             
-            if (enemyRect.intersects(playerRect)) {
-                // Compute overlaps along X and Y
-                float overlapX = std::min(enemyRect.left + enemyRect.width, playerRect.left + playerRect.width)
-                                 - std::max(enemyRect.left, playerRect.left);
-                float overlapY = std::min(enemyRect.top + enemyRect.height, playerRect.top + playerRect.height)
-                                 - std::max(enemyRect.top, playerRect.top);
-
-                const float MIN_VERTICAL_SEPARATION = 5.f;
-                float separation = std::max(overlapY * COLLISION_SEPARATION_FACTOR, MIN_VERTICAL_SEPARATION);
+            // Adjusted bounce speeds
+            const float playerVerticalBounceSpeed = 250.f;
+            
+            // Check if player is moving downward (falling or jumping down)
+            bool playerFalling = pTrans.velocity.y > 0;
+
+            // If player is jumping on enemy from above
+            if (playerFalling && pTrans.pos.y < enemyTrans.pos.y && overlapY < overlapX) {
+                // Player is landing on enemy from above
+                pTrans.pos.y -= separation;
+                pTrans.velocity.y = -playerVerticalBounceSpeed; // Controlled upward bounce for player
                 
-                // Adjusted bounce speeds
-                const float playerVerticalBounceSpeed = 250.f;
+                // Set a small invincibility period for the player
+                pState.isInvincible = true;
+                pState.invincibilityTimer = 0.2f;
                 
-                // Check if player is moving downward (falling or jumping down)
-                bool playerFalling = pTrans.velocity.y > 0;
-
-                // If player is jumping on enemy from above
-                if (playerFalling && pTrans.pos.y < enemyTrans.pos.y && overlapY < overlapX) {
-                    // Player is landing on enemy from above
-                    pTrans.pos.y -= separation;
-                    pTrans.velocity.y = -playerVerticalBounceSpeed; // Controlled upward bounce for player
-                    
-                    // Set a small invincibility period for the player
-                    pState.isInvincible = true;
-                    pState.invincibilityTimer = 0.2f;
-                    
-                    // Optional: Give the player a "bounce" feeling
-                    pState.isJumping = true;
-                    pState.jumpTime = 0.1f; // Short jump time to maintain control
-                    
-                    continue; // Skip other collision handling for this interaction
-                }
+                // Optional: Give the player a "bounce" feeling
+                pState.isJumping = true;
+                pState.jumpTime = 0.1f; // Short jump time to maintain control
                 
-                // Horizontal collision - prevent player from going through
-                if (overlapX <= overlapY) {
-                    // Make player back away by 20 pixels
-                    auto& enemyAI = enemy->get<CEnemyAI>();
-                    if (enemyAI.enemyType == EnemyType::Emperor) {
-                        float backDirection = (enemyTrans.pos.x < pTrans.pos.x) ? 1.0f : -1.0f;
-                        pTrans.pos.x += 20.0f * backDirection;
-                    }
+                continue; // Skip other collision handling for this interaction
+            }
+            
+            // Horizontal collision - prevent player from going through
+            if (overlapX <= overlapY) {
+                // Make player back away by 20 pixels
+                auto& enemyAI = enemy->get<CEnemyAI>();
+                if (enemyAI.enemyType == EnemyType::Emperor) {
+                    float backDirection = (enemyTrans.pos.x < pTrans.pos.x) ? 1.0f : -1.0f;
+                    pTrans.pos.x += 20.0f * backDirection;
+                }
+            } 
+            // Other vertical collision cases
+            else {
+                // If enemy is above player
+                if (enemyTrans.pos.y < pTrans.pos.y) {
+                    pTrans.pos.y = enemyRect.top + enemyRect.height + 1.0f;
+                    pTrans.velocity.y = 0;
                 } 
-                // Other vertical collision cases
+                // Enemy is below player
                 else {
-                    // If enemy is above player
-                    if (enemyTrans.pos.y < pTrans.pos.y) {
-                        pTrans.pos.y = enemyRect.top + enemyRect.height + 1.0f;
-                        pTrans.velocity.y = 0;
-                    } 
-                    // Enemy is below player
-                    else {
-                        pTrans.pos.y = enemyRect.top - pBB.halfSize.y - 1.0f;
-                        pTrans.velocity.y = 0;
-                    }
+                    pTrans.pos.y = enemyRect.top - pBB.halfSize.y - 1.0f;
+                    pTrans.velocity.y = 0;
                 }
             }
         }
@@ -520,7 +649,7 @@ void CollisionSystem::handlePlayerEnemyCollisions() {
 }
 
 void CollisionSystem::handlePlayerBulletCollisions() {
-    for (auto& bullet : m_entityManager.getEntities("playerBullet")) {
+    for (auto& bullet : m_entityManager.getEntities(TagId::PlayerBullet)) {
         if (!bullet->has<CTransform>() || !bullet->has<CBoundingBox>())
             continue;
 
@@ -529,7 +658,7 @@ void CollisionSystem::handlePlayerBulletCollisions() {
         sf::FloatRect bulletRect = bulletBB.getRect(bulletTrans.pos);
 
         // Destroy bullet if it hits a tile
-        for (auto& tile : m_entityManager.getEntities("tile")) {
+        for (auto& tile : tilesIn(bulletRect)) {
             if (!tile->has<CTransform>() || !tile->has<CBoundingBox>() || !tile->has<CAnimation>())
                 continue;
 
@@ -544,55 +673,52 @@ void CollisionSystem::handlePlayerBulletCollisions() {
             bullet->destroy();
 
             // If the tile is a "Box", destroy it
-            std::string animName = tileAnim.getName();
+            const std::string& animName = tileAnim.getName();
             if (animName.find("Box") != std::string::npos) {
                 // If you want to spawn items or fragments:
                 m_spawner->createBlockFragments(tileTrans.pos, animName);
                 m_spawner->spawnItem(tileTrans.pos, animName);
-                tile->destroy();
+                destroyTile(tile);
             }
             break; // Stop checking after first tile collision
         }
+    }
 
-        // Destroy bullet if it hits an enemy
-        for (auto& enemy : m_entityManager.getEntities("enemy")) {
-            if (!enemy->has<CTransform>() || !enemy->has<CBoundingBox>())
-                continue;
-
-            auto& enemyTrans = enemy->get<CTransform>();
-            auto& enemyBB    = enemy->get<CBoundingBox>();
-            sf::FloatRect enemyRect = enemyBB.getRect(enemyTrans.pos);
+    // Get bullet damage from player's CState
+    float bulletDamage = 5.0f; // Default damage if we can't find the player
+    auto players = m_entityManager.getEntities(TagId::Player);
+    if (!players.empty() && players.front()->has<CState>()) {
+        bulletDamage = players.front()->get<CState>().bulletDamage;
+    }
 
-            if (!bulletRect.intersects(enemyRect))
-                continue; 
+    // Destroy bullet if it hits an enemy (first enemy only)
+    Entity* spentBullet = nullptr;
+    for (auto& pair : m_broadphase.pairs(TagId::PlayerBullet, TagId::Enemy)) {
+        Entity* bullet = pair.first;
+        Entity* enemy  = pair.second;
+        if (bullet == spentBullet)
+            continue;
 
+        sf::FloatRect bulletRect = bullet->getBounds();
+        sf::FloatRect enemyRect  = enemy->getBounds();
+        if (!overlaps(pair, bulletRect, enemyRect))
+            continue; 
 
-            if (enemy->has<CHealth>()) {
-                // Get bullet damage from player's CState
-                float bulletDamage = 5.0f; // Default damage if we can't find the player
-                
-                // Find the player and get their bullet damage
-                auto players = m_entityManager.getEntities("player");
-                if (!players.empty() && players.front()->has<CState>()) {
-                    bulletDamage = players.front()->get<CState>().bulletDamage;
-                }
-                
-                // Apply damage to enemy
-                auto& health = enemy->get<CHealth>();
-                int damageToApply = static_cast<int>(bulletDamage);
-                health.takeDamage(damageToApply);
-                
-            }
-            
-            bullet->destroy();
-            break; 
+        if (enemy->has<CHealth>()) {
+            // Apply damage to enemy
+            auto& health = enemy->get<CHealth>();
+            int damageToApply = static_cast<int>(bulletDamage);
+            health.takeDamage(damageToApply);
         }
+        
+        bullet->destroy();
+        spentBullet = bullet;
     }
 }
 
 
 void CollisionSystem::handleBulletPlayerCollisions() {
-    for (auto& bullet : m_entityManager.getEntities("enemyBullet")) {
+    for (auto& bullet : m_entityManager.getEntities(TagId::EnemyBullet)) {
         if (!bullet->has<CTransform>() || !bullet->has<CBoundingBox>()) 
             continue;
 
@@ -600,9 +726,11 @@ void CollisionSystem::handleBulletPlayerCollisions() {
         auto& bulletBB    = bullet->get<CBoundingBox>();
         sf::FloatRect bulletRect = bulletBB.getRect(bulletTrans.pos);
 
+        bool isSuper2Bullet = isSuper2(bullet);
+
         // Destroy bullet if it hits a tile
         // Check for bullet collision with tiles
-        for (auto& tile : m_entityManager.getEntities("tile")) {
+        for (auto& tile : tilesIn(bulletRect)) {
             if (!tile->has<CTransform>() || !tile->has<CBoundingBox>())
                 continue;
 
@@ -610,26 +738,13 @@ void CollisionSystem::handleBulletPlayerCollisions() {
             auto& tileBB    = tile->get<CBoundingBox>();
             sf::FloatRect tileRect = tileBB.getRect(tileTrans.pos);
 
-            bool isSuper2Bullet = false;
-            if (bullet->has<CState>()) {
-                std::string parentId = bullet->get<CState>().state;
-                for (auto& enemy : m_entityManager.getEntities("enemy")) {
-                    if (std::to_string(enemy->id()) == parentId && 
-                        enemy->has<CEnemyAI>() && 
-                        enemy->get<CEnemyAI>().enemyType == EnemyType::Super2) {
-                        isSuper2Bullet = true;
-                        break;
-                    }
-                }
-            }
-
             if (bulletRect.intersects(tileRect)) {
                 if (isSuper2Bullet) {
                     // Super2 bullets destroy tiles
                     auto& tileAnim      = tile->get<CAnimation>().animation;
-                    std::string animName = tileAnim.getName();
+                    const std::string& animName = tileAnim.getName();
                     m_spawner->createBlockFragments(tileTrans.pos, animName);
-                    tile->destroy();
+                    destroyTile(tile);
                 } else {
                     // Regular bullets get destroyed by tiles
                     bullet->destroy();
@@ -637,126 +752,113 @@ void CollisionSystem::handleBulletPlayerCollisions() {
                 break;
             }
         }
-        // Check for bullet collision with citizens
-        for (auto& citizen : m_entityManager.getEntities("enemy")) {
-            // Skip if not a citizen
-            if (!citizen->has<CEnemyAI>() || 
-                citizen->get<CEnemyAI>().enemyType != EnemyType::Citizen ||
-                !citizen->has<CTransform>() || !citizen->has<CBoundingBox>())
-                continue;
-            
-            auto& citizenTrans = citizen->get<CTransform>();
-            auto& citizenBB = citizen->get<CBoundingBox>();
-            sf::FloatRect citizenRect = citizenBB.getRect(citizenTrans.pos);
+    }
+
+    // Check for bullet collision with citizens
+    Entity* spentBullet = nullptr;
+    for (auto& pair : m_broadphase.pairs(TagId::EnemyBullet, TagId::Enemy)) {
+        Entity* bullet  = pair.first;
+        Entity* citizen = pair.second;
+        if (bullet == spentBullet)
+            continue;
+
+        // Skip if not a citizen
+        if (!citizen->has<CEnemyAI>() || 
+            citizen->get<CEnemyAI>().enemyType != EnemyType::Citizen)
+            continue;
+        
+        sf::FloatRect bulletRect  = bullet->getBounds();
+        sf::FloatRect citizenRect = citizen->getBounds();
+        
+        if (overlaps(pair, bulletRect, citizenRect)) {
+            // Kill the citizen
+            if (citizen->has<CHealth>()) {
+                auto& health = citizen->get<CHealth>();
+                health.currentHealth = 0;
+            } else {
+                citizen->destroy();
+            }
             
-            if (bulletRect.intersects(citizenRect)) {
-                // Kill the citizen
-                if (citizen->has<CHealth>()) {
-                    auto& health = citizen->get<CHealth>();
-                    health.currentHealth = 0;
-                } else {
-                    citizen->destroy();
-                }
-                
-                // Also destroy the bullet (unless it's a Super2 bullet)
-                bool isSuper2Bullet = false;
-                if (bullet->has<CState>()) {
-                    std::string parentId = bullet->get<CState>().state;
-                    for (auto& enemy : m_entityManager.getEntities("enemy")) {
-                        if (std::to_string(enemy->id()) == parentId && 
-                            enemy->has<CEnemyAI>() && 
-                            enemy->get<CEnemyAI>().enemyType == EnemyType::Super2) {
-                            isSuper2Bullet = true;
-                            break;
-                        }
-                    }
-                }
-                
-                if (!isSuper2Bullet) {
-                    bullet->destroy();
-                }
-                break;
+            // Also destroy the bullet (unless it's a Super2 bullet)
+            if (!isSuper2(bullet)) {
+                bullet->destroy();
             }
+            spentBullet = bullet;
         }
+    }
 
-        // Check for bullet collision with player
-        for (auto& player : m_entityManager.getEntities("player")) {
-            if (!player->has<CTransform>() || !player->has<CBoundingBox>())
-                continue;
+    // Check for bullet collision with player
+    spentBullet = nullptr;
+    for (auto& pair : m_broadphase.pairs(TagId::EnemyBullet, TagId::Player)) {
+        Entity* bullet = pair.first;
+        Entity* player = pair.second;
+        if (bullet == spentBullet)
+            continue;
 
-            auto& playerTrans = player->get<CTransform>();
-            auto& playerBB    = player->get<CBoundingBox>();
-            sf::FloatRect playerRect = playerBB.getRect(playerTrans.pos);
+        sf::FloatRect bulletRect = bullet->getBounds();
+        sf::FloatRect playerRect = player->getBounds();
 
-            if (!bulletRect.intersects(playerRect))
-                continue;
+        if (!overlaps(pair, bulletRect, playerRect))
+            continue;
 
-            // If player is invincible, ignore bullet
-            if (player->has<CState>()) {
-                auto& st = player->get<CState>();
-                if (st.state == "defense") {
-                    bullet->destroy();
-                    break;
-                }
+        spentBullet = bullet;
+
+        // If player is invincible, ignore bullet
+        if (player->has<CState>()) {
+            auto& st = player->get<CState>();
+            if (st.state == "defense") {
+                bullet->destroy();
+                continue;
             }
+        }
 
-            // Apply damage to player
-            if (player->has<CHealth>()) {
-                auto& health = player->get<CHealth>();
-                if (health.invulnerabilityTimer <= 0.f) {
-                    // Default damage if we can't determine the source
-                    int bulletDamage = 10;
-                    
-                    // Get the enemy ID from the bullet's state
-                    if (bullet->has<CState>()) {
-                        std::string enemyIdStr = bullet->get<CState>().state;
-                        
-                    // Try to convert the string to a numeric ID
-                    int enemyId = std::stoi(enemyIdStr);
-                    
-                    // Find the enemy with this ID
-                    for (auto& enemy : m_entityManager.getEntities("enemy")) {
-                        if (enemy->id() == static_cast<size_t>(enemyId) && enemy->has<CEnemyAI>()) {
-                            // Get damage from the original enemy
-                            bulletDamage = enemy->get<CState>().bulletDamage;
+        // Apply damage to player
+        if (player->has<CHealth>()) {
+            auto& health = player->get<CHealth>();
+            if (health.invulnerabilityTimer <= 0.f) {
+                // Default damage if we can't determine the source
+                int bulletDamage = 10;
+                
+                // Get the enemy ID from the bullet's state
+                if (bullet->has<CState>()) {
+                    Entity* enemy = findEnemy(bullet->get<CState>().state);
+                    if (enemy && enemy->has<CEnemyAI>()) {
+                        // Get damage from the original enemy
+                        bulletDamage = enemy->get<CState>().bulletDamage;
 
                         // Apply 0.6 multiplier if the enemy is Emperor
                         if (enemy->get<CEnemyAI>().enemyType == EnemyType::Emperor) {
                             bulletDamage = static_cast<int>(bulletDamage * 0.6f);
                         }
-                            break;
-                        }
-                    }
-                    }
-                    // Apply FutureArmor protection if relevant
-                    bool hasFutureArmor = false;
-                    if (player->has<CPlayerEquipment>()) {
-                        hasFutureArmor = player->get<CPlayerEquipment>().hasFutureArmor;
-                    }
-                    
-                    if (!hasFutureArmor) {
-                        bulletDamage = static_cast<int>(bulletDamage * 1.5f);
-                        // std::cout << "[DEBUG] Player without FutureArmor => bulletDamage x1.5 => " 
-                        //           << bulletDamage << "\n";
                     }
-                    
-                    // Apply the damage
-                    health.takeDamage(bulletDamage);
-                    health.invulnerabilityTimer = PLAYER_HIT_INVULNERABILITY_TIME;
-                    // std::cout << "[DEBUG] Player hit by bullet! Damage: " 
-                    //           << bulletDamage << " Health: " << health.currentHealth << "\n";
-                } else {
-                    // std::cout << "[DEBUG] Player already invincible, ignoring bullet.\n";
                 }
+                // Apply FutureArmor protection if relevant
+                bool hasFutureArmor = false;
+                if (player->has<CPlayerEquipment>()) {
+                    hasFutureArmor = player->get<CPlayerEquipment>().hasFutureArmor;
+                }
+                
+                if (!hasFutureArmor) {
+                    bulletDamage = static_cast<int>(bulletDamage * 1.5f);
+                    // std::cout << "[DEBUG] Player without FutureArmor => bulletDamage x1.5 => " 
+                    //           << bulletDamage << "\n";
+                }
+                
+                // Apply the damage
+                health.takeDamage(bulletDamage);
+                health.invulnerabilityTimer = PLAYER_HIT_INVULNERABILITY_TIME;
+                // std::cout << "[DEBUG] Player hit by bullet! Damage: " 
+                //           << bulletDamage << " Health: " << health.currentHealth << "\n";
+            } else {
+                // std::cout << "[DEBUG] Player already invincible, ignoring bullet.\n";
             }
-
-            bullet->destroy();
-            break; 
         }
+
+        bullet->destroy();
     }
 }
 void CollisionSystem::handleBlackHoleTileCollisions() {
-    for (auto& blackHole : m_entityManager.getEntities("emperorBlackHole")) {
+    for (auto& blackHole : m_entityManager.getEntities(TagId::EmperorBlackHole)) {
         if (!blackHole->has<CTransform>() || !blackHole->has<CBoundingBox>()) 
             continue;
 
@@ -765,13 +867,13 @@ void CollisionSystem::handleBlackHoleTileCollisions() {
         sf::FloatRect blackHoleRect = blackHoleBB.getRect(blackHoleTrans.pos);
 
         // Check for collisions with tiles
-        for (auto& tile : m_entityManager.getEntities("tile")) {
+        for (auto& tile : tilesIn(blackHoleRect)) {
             if (!tile->has<CTransform>() || !tile->has<CBoundingBox>())
                 continue;
 
             // Skip collision detection if tile is PipeTall or LevelDoor
             if (tile->has<CAnimation>()) {
-                std::string tileAnimName = tile->get<CAnimation>().animation.getName();
+                const std::string& tileAnimName = tile->get<CAnimation>().animation.getName();
                 if (tileAnimName == "PipeTall" || tileAnimName == "LevelDoor") {
                     continue; // Skip this tile
                 }
@@ -782,11 +884,8 @@ void CollisionSystem::handleBlackHoleTileCollisions() {
             sf::FloatRect tileRect = tileBB.getRect(tileTrans.pos);
 
             if (blackHoleRect.intersects(tileRect)) {
-                // Get the black hole's animation name to determine its type
-                std::string blackHoleAnimName = blackHole->get<CAnimation>().animation.getName();
-                
                 // Protect tiles beyond x=3744 only in the emperor room level
-                bool protectedTile = (m_levelPath.find("future_rome_level_4_emperor_room") != std::string::npos && (tileTrans.pos.x < 400 || tileTrans.pos.x > 3600 ||  tileTrans.pos.y <-550));
+                bool protectedTile = (m_isEmperorRoom && (tileTrans.pos.x < 400 || tileTrans.pos.x > 3600 ||  tileTrans.pos.y <-550));
                 if (protectedTile) {
                     continue;
                 }
@@ -795,43 +894,45 @@ void CollisionSystem::handleBlackHoleTileCollisions() {
                 //           << tileTrans.pos.x << "," << tileTrans.pos.y << ")\n";
                 
                 auto& tileAnim = tile->get<CAnimation>().animation;
-                std::string animName = tileAnim.getName();
+                const std::string& animName = tileAnim.getName();
                 m_spawner->createBlockFragments(tileTrans.pos, animName);
-                tile->destroy();
+                destroyTile(tile);
                 
                 break; // Move to the next black hole after handling one tile collision
             }
         }
-        
-        // Also check for player collision
-        for (auto& player : m_entityManager.getEntities("player")) {
-            if (!player->has<CTransform>() || !player->has<CBoundingBox>())
-                continue;
+    }
 
-            auto& playerTrans = player->get<CTransform>();
-            auto& playerBB = player->get<CBoundingBox>();
-            sf::FloatRect playerRect = playerBB.getRect(playerTrans.pos);
+    // Also check for player collision
+    Entity* spentBlackHole = nullptr;
+    for (auto& pair : m_broadphase.pairs(TagId::EmperorBlackHole, TagId::Player)) {
+        Entity* blackHole = pair.first;
+        Entity* player    = pair.second;
+        if (blackHole == spentBlackHole)
+            continue;
 
-            if (blackHoleRect.intersects(playerRect)) {
-                // When player collides with black hole, instant death
-                if (player->has<CHealth>()) {
-                    auto& health = player->get<CHealth>();
-                    
-                    // Force health to 0 for instant death
-                    health.currentHealth = 0;
-                }
+        sf::FloatRect blackHoleRect = blackHole->getBounds();
+        sf::FloatRect playerRect    = player->getBounds();
 
-                // Destroy the black hole after hitting player
-                blackHole->destroy();
-                break;
+        if (overlaps(pair, blackHoleRect, playerRect)) {
+            // When player collides with black hole, instant death
+            if (player->has<CHealth>()) {
+                auto& health = player->get<CHealth>();
+                
+                // Force health to 0 for instant death
+                health.currentHealth = 0;
             }
+
+            // Destroy the black hole after hitting player
+            blackHole->destroy();
+            spentBlackHole = blackHole;
         }
     }
 }
 
 void CollisionSystem::handleSwordCollisions() {
     // Player sword
-    for (auto& sword : m_entityManager.getEntities("sword")) {
+    for (auto& sword : m_entityManager.getEntities(TagId::Sword)) {
         if (!sword->has<CTransform>() || !sword->has<CBoundingBox>())
             continue;
 
@@ -840,7 +941,7 @@ void CollisionSystem::handleSwordCollisions() {
         sf::FloatRect swordRect = swBB.getRect(swTrans.pos);
 
         // --- Player Sword vs Tile ---
-        for (auto& tile : m_entityManager.getEntities("tile")) {
+        for (auto& tile : tilesIn(swordRect)) {
             if (!tile->has<CTransform>() || !tile->has<CBoundingBox>() || !tile->has<CAnimation>())
                 continue;
 
@@ -851,66 +952,68 @@ void CollisionSystem::handleSwordCollisions() {
 
             if (swordRect.intersects(tileRect)) {
                 // std::cout << "[DEBUG] Player sword hit tile!\n";
-                std::string animName = tileAnim.getName();
+                const std::string& animName = tileAnim.getName();
                 if (animName.find("Box") != std::string::npos) {
                     m_spawner->createBlockFragments(tileTransform.pos, animName);
                     m_spawner->spawnItem(tileTransform.pos, animName);
-                    tile->destroy();
+                    destroyTile(tile);
                     // std::cout << "[DEBUG] " << animName << " broken by player's sword!\n";
                 }
             }
         }
+    }
 
-        // --- Player Sword vs Enemy ---
-        for (auto& enemy : m_entityManager.getEntities("enemy")) {
-            if (!enemy->has<CTransform>() || !enemy->has<CBoundingBox>())
-                continue;
-        
-            auto& enemyTrans = enemy->get<CTransform>();
-            auto& enemyBB    = enemy->get<CBoundingBox>();
-            sf::FloatRect enemyRect = enemyBB.getRect(enemyTrans.pos);
-        
-            if (swordRect.intersects(enemyRect)) {
-                // std::cout << "[DEBUG] Player sword hit enemy!\n";
-                
-                // Direct check for Emperor
-                bool isEmperor = enemy->has<CEnemyAI>() && 
-                                enemy->get<CEnemyAI>().enemyType == EnemyType::Emperor;
+    // Reduce damage in Future world without FutureArmor
+    bool playerLacksArmor = false;
+    auto players = m_entityManager.getEntities(TagId::Player);
+    if (!players.empty() && players.front()->has<CPlayerEquipment>()) {
+        playerLacksArmor = !players.front()->get<CPlayerEquipment>().hasFutureArmor;
+    }
+
+    // --- Player Sword vs Enemy ---
+    for (auto& pair : m_broadphase.pairs(TagId::Sword, TagId::Enemy)) {
+        Entity* sword = pair.first;
+        Entity* enemy = pair.second;
+
+        sf::FloatRect swordRect = sword->getBounds();
+        sf::FloatRect enemyRect = enemy->getBounds();
+    
+        if (overlaps(pair, swordRect, enemyRect)) {
+            // std::cout << "[DEBUG] Player sword hit enemy!\n";
+            
+            // Direct check for Emperor
+            bool isEmperor = enemy->has<CEnemyAI>() && 
+                            enemy->get<CEnemyAI>().enemyType == EnemyType::Emperor;
+            
+            // Apply damage with protection for Emperor
+            if (enemy->has<CHealth>()) {
+                auto& health = enemy->get<CHealth>();
+                if (health.invulnerabilityTimer > 0.f) {
+                    continue; // Skip damage if currently invincible
+                }
+                int damage = PLAYER_SWORD_DAMAGE;
                 
-                // Apply damage with protection for Emperor
-                if (enemy->has<CHealth>()) {
-                    auto& health = enemy->get<CHealth>();
-                    if (health.invulnerabilityTimer > 0.f) {
-                        continue; // Skip damage if currently invincible
+                if (m_game.worldType == "Future" || (m_game.worldType == "Alien" && enemy->has<CEnemyAI>() && enemy->get<CEnemyAI>().enemyType == EnemyType::Fast)) {
+                    if (playerLacksArmor) {
+                        damage = static_cast<int>(damage / 3.f);
+                        // std::cout << "[DEBUG] Future world + no FutureArmor: sword damage reduced to " 
+                        //         << damage << "\n";
                     }
-                    int damage = PLAYER_SWORD_DAMAGE;
-                    
-                    // Reduce damage in Future world without FutureArmor
-                    if (m_game.worldType == "Future" || (m_game.worldType == "Alien" && enemy->has<CEnemyAI>() && enemy->get<CEnemyAI>().enemyType == EnemyType::Fast)) {
-                        auto players = m_entityManager.getEntities("player");
-                        if (!players.empty() && players.front()->has<CPlayerEquipment>()) {
-                            if (!players.front()->get<CPlayerEquipment>().hasFutureArmor) {
-                                damage = static_cast<int>(damage / 3.f);
-                                // std::cout << "[DEBUG] Future world + no FutureArmor: sword damage reduced to " 
-                                //         << damage << "\n";
-                            }
-                        }
-                    }
-                    
-                    // For Emperor, ensure health never goes below 1
-                    // APPLY damage and invincibility differently if Emperor
-                    if (isEmperor) {
-                        int newHealth = health.currentHealth - damage;
-                        if (newHealth < 1) newHealth = 1;
-                        health.currentHealth = newHealth;
-                        health.invulnerabilityTimer = 1.f; // Short invincibility
-                        // std::cout << "[DEBUG] Emperor took damage. New Health: " << health.currentHealth << "\n";
-                    } else {
-                        health.takeDamage(damage);
-                        health.invulnerabilityTimer = PLAYER_SWORD_INVULNERABILITY_TIME;
-                        if (!health.isAlive()) {
-                            enemy->destroy();
-                        }
+                }
+                
+                // For Emperor, ensure health never goes below 1
+                // APPLY damage and invincibility differently if Emperor
+                if (isEmperor) {
+                    int newHealth = health.currentHealth - damage;
+                    if (newHealth < 1) newHealth = 1;
+                    health.currentHealth = newHealth;
+                    health.invulnerabilityTimer = 1.f; // Short invincibility
+                    // std::cout << "[DEBUG] Emperor took damage. New Health: " << health.currentHealth << "\n";
+                } else {
+                    health.takeDamage(damage);
+                    health.invulnerabilityTimer = PLAYER_SWORD_INVULNERABILITY_TIME;
+                    if (!health.isAlive()) {
+                        enemy->destroy();
                     }
                 }
             }
@@ -918,7 +1021,7 @@ void CollisionSystem::handleSwordCollisions() {
     }
     
     // Enemy sword collisions
-    for (auto& enemySword : m_entityManager.getEntities("enemySword")) {
+    for (auto& enemySword : m_entityManager.getEntities(TagId::EnemySword)) {
         if (!enemySword->has<CTransform>() || !enemySword->has<CBoundingBox>())
             continue;
 
@@ -927,7 +1030,7 @@ void CollisionSystem::handleSwordCollisions() {
         sf::FloatRect swordRect = swBB.getRect(swTrans.pos);
 
         // Enemy sword vs tile
-        for (auto& tile : m_entityManager.getEntities("tile")) {
+        for (auto& tile : tilesIn(swordRect)) {
             if (!tile->has<CTransform>() || !tile->has<CBoundingBox>())
                 continue;
 
@@ -955,342 +1058,288 @@ void CollisionSystem::handleSwordCollisions() {
 
             if (shouldDestroyTile) {
                 // Create block fragments & spawn item
-                std::string animName = tileAnim.getName();
+                const std::string& animName = tileAnim.getName();
                 // std::cout << "[DEBUG] Spawning black hole!!!\n";
                 m_spawner->createBlockFragments(tileTransform.pos, animName);
-                tile->destroy();  // Destroy tile
+                destroyTile(tile);  // Destroy tile
             }
 
             enemySword->destroy(); // Destroy the sword on impact
             break; // Exit loop after handling collision
         }
+    }
         
-        //Collisions with Player
-        for (auto& player : m_entityManager.getEntities("player")) {
-            if (!player->has<CTransform>() || !player->has<CBoundingBox>())
+    //Collisions with Player
+    Entity* spentSword = nullptr;
+    for (auto& pair : m_broadphase.pairs(TagId::EnemySword, TagId::Player)) {
+        Entity* enemySword = pair.first;
+        Entity* player     = pair.second;
+        if (enemySword == spentSword)
+            continue;
+
+        // If player is defending, ignore damage
+        if (player->has<CState>()) {
+            auto& st = player->get<CState>();
+            if (st.state == "defense") {
+                //std::cout << "[DEBUG] Player in defense, ignoring Emperor sword damage.\n";
+                spentSword = enemySword;
                 continue;
-            
-            auto& playerTrans = player->get<CTransform>();
-            auto& playerBB    = player->get<CBoundingBox>();
-            sf::FloatRect playerRect = playerBB.getRect(playerTrans.pos);
-
-            // If player is defending, ignore damage
-            if (player->has<CState>()) {
-                auto& st = player->get<CState>();
-                if (st.state == "defense") {
-                    //std::cout << "[DEBUG] Player in defense, ignoring Emperor sword damage.\n";
-                    break;
-                }
             }
-            if (swordRect.intersects(playerRect)) {
-                if (player->has<CHealth>()) {
-                    auto& health = player->get<CHealth>();
-                    health.takeDamage(enemySword->get<CEnemyAI>().damage);
-                    // std::cout << "[DEBUG] Enemy sword hit player! Damage: " << enemySword->get<CEnemyAI>().damage << "\n";
-                }
-                enemySword->destroy(); // Destroy sword after hit
-                break; 
+        }
+        if (overlaps(pair, enemySword->getBounds(), player->getBounds())) {
+            if (player->has<CHealth>()) {
+                auto& health = player->get<CHealth>();
+                health.takeDamage(enemySword->get<CEnemyAI>().damage);
+                // std::cout << "[DEBUG] Enemy sword hit player! Damage: " << enemySword->get<CEnemyAI>().damage << "\n";
             }
+            enemySword->destroy(); // Destroy sword after hit
+            spentSword = enemySword;
         }
+    }
         
-        // Enemy sword vs other enemies
-        for (auto& otherEnemy : m_entityManager.getEntities("enemy")) {
-            if (!otherEnemy->has<CTransform>() || !otherEnemy->has<CBoundingBox>() || otherEnemy->get<CEnemyAI>().enemyType == EnemyType::Super)
-                continue;
-            
-            auto& enemyTrans = otherEnemy->get<CTransform>();
-            auto& enemyBB = otherEnemy->get<CBoundingBox>();
-            sf::FloatRect enemyRect = enemyBB.getRect(enemyTrans.pos);
+    // Enemy sword vs other enemies
+    spentSword = nullptr;
+    for (auto& pair : m_broadphase.pairs(TagId::EnemySword, TagId::Enemy)) {
+        Entity* enemySword = pair.first;
+        Entity* otherEnemy = pair.second;
+        if (enemySword == spentSword || otherEnemy->get<CEnemyAI>().enemyType == EnemyType::Super)
+            continue;
+        
+        if (overlaps(pair, enemySword->getBounds(), otherEnemy->getBounds())) {
+            // Direct check for Emperor
+            bool isEmperor = otherEnemy->has<CEnemyAI>() && 
+                            otherEnemy->get<CEnemyAI>().enemyType == EnemyType::Emperor;
             
-            if (swordRect.intersects(enemyRect)) {
-                // Direct check for Emperor
-                bool isEmperor = otherEnemy->has<CEnemyAI>() && 
-                                otherEnemy->get<CEnemyAI>().enemyType == EnemyType::Emperor;
-                
-                if (isEmperor) {
-                    // std::cout << "[DEBUG] Emperor is immortal - limiting sword damage!\n";
-                }
+            if (isEmperor) {
+                // std::cout << "[DEBUG] Emperor is immortal - limiting sword damage!\n";
+            }
 
-                // Get the enemy that created this sword
-                int creatorId = -1;
-                if (enemySword->has<CState>()) {
-                    try {
-                        creatorId = std::stoi(enemySword->get<CState>().state);
-                    } catch (...) {
-                        // Invalid ID format, continue
-                    }
-                }
+            // Get the enemy that created this sword (null if unknown)
+            Entity* creator = enemySword->has<CState>() ? findEnemy(enemySword->get<CState>().state) : nullptr;
+            
+            // Don't let enemy's own sword hit itself
+            if (creator != otherEnemy) {
+                // std::cout << "[DEBUG] Enemy sword hit another enemy! Sword: " 
+                //         << enemySword->id() << " Hit Enemy: " << otherEnemy->id() << "\n";
                 
-                // Don't let enemy's own sword hit itself
-                if (static_cast<size_t>(creatorId) != otherEnemy->id()) {
-                    // std::cout << "[DEBUG] Enemy sword hit another enemy! Sword: " 
-                    //         << enemySword->id() << " Hit Enemy: " << otherEnemy->id() << "\n";
+                // Apply damage if needed
+                if (otherEnemy->has<CHealth>() && enemySword->has<CEnemyAI>()) {
+                    auto& health = otherEnemy->get<CHealth>();
+                    auto& swordAI = enemySword->get<CEnemyAI>();
                     
-                    // Apply damage if needed
-                    if (otherEnemy->has<CHealth>() && enemySword->has<CEnemyAI>()) {
-                        auto& health = otherEnemy->get<CHealth>();
-                        auto& swordAI = enemySword->get<CEnemyAI>();
-                        
-                        // Check if Emperor and protect health
-                        if (isEmperor) {
-                            int newHealth = health.currentHealth - swordAI.damage;
-                            if (newHealth < 1) newHealth = 1;
-                            health.currentHealth = newHealth;
-                        } else {
-                            health.takeDamage(swordAI.damage);
-                            if (!health.isAlive()) {
-                                otherEnemy->destroy();
-                            }
+                    // Check if Emperor and protect health
+                    if (isEmperor) {
+                        int newHealth = health.currentHealth - swordAI.damage;
+                        if (newHealth < 1) newHealth = 1;
+                        health.currentHealth = newHealth;
+                    } else {
+                        health.takeDamage(swordAI.damage);
+                        if (!health.isAlive()) {
+                            otherEnemy->destroy();
                         }
                     }
-                    
-                    // Destroy the sword after hitting another enemy
-                    enemySword->destroy();
-                    break; // Exit this enemy loop
                 }
+                
+                // Destroy the sword after hitting another enemy
+                enemySword->destroy();
+                spentSword = enemySword;
             }
         }
     }
 
     // Emperor sword collisions
-    for (auto& empSword : m_entityManager.getEntities("EmperorSword")) {
-        // Check for required components
-        if (!empSword->has<CTransform>() || !empSword->has<CBoundingBox>())
+    // EmperorSword vs Player
+    spentSword = nullptr;
+    for (auto& pair : m_broadphase.pairs(TagId::EmperorSword, TagId::Player)) {
+        Entity* empSword = pair.first;
+        Entity* player   = pair.second;
+        if (empSword == spentSword)
             continue;
 
-        auto& swTrans = empSword->get<CTransform>();
-        auto& swBB    = empSword->get<CBoundingBox>();
-
-        sf::FloatRect swordRect = swBB.getRect(swTrans.pos);
-
-        // EmperorSword vs Player
-        for (auto& player : m_entityManager.getEntities("player")) {
-            if (!player->has<CTransform>() || !player->has<CBoundingBox>())
-                continue;
+        if (!overlaps(pair, empSword->getBounds(), player->getBounds()))
+            continue;
 
-            auto& pTrans = player->get<CTransform>();
-            auto& pBB    = player->get<CBoundingBox>();
-            sf::FloatRect playerRect = pBB.getRect(pTrans.pos);
+        spentSword = empSword;
 
-            if (!swordRect.intersects(playerRect))
+        // If player is defending, ignore damage
+        if (player->has<CState>()) {
+            auto& st = player->get<CState>();
+            if (st.state == "defense") {
+                //std::cout << "[DEBUG] Player in defense, ignoring Emperor sword damage.\n";
                 continue;
-
-            // If player is defending, ignore damage
-            if (player->has<CState>()) {
-                auto& st = player->get<CState>();
-                if (st.state == "defense") {
-                    //std::cout << "[DEBUG] Player in defense, ignoring Emperor sword damage.\n";
-                    break;
-                }
             }
+        }
 
-            // Damage to player
-            if (player->has<CHealth>()) {
-                auto& health = player->get<CHealth>();
-                int empSwordDamage = 10; // default
-                if (empSword->has<CEnemyAI>()) {
-                    empSwordDamage = empSword->get<CEnemyAI>().damage;
-                }
-                health.takeDamage(empSwordDamage);
-                health.invulnerabilityTimer = PLAYER_HIT_INVULNERABILITY_TIME;
-                // std::cout << "[DEBUG] Player hit by emperor sword! Damage: " 
-                //         << empSwordDamage 
-                //         << " Health: " << health.currentHealth << "\n";
+        // Damage to player
+        if (player->has<CHealth>()) {
+            auto& health = player->get<CHealth>();
+            int empSwordDamage = 10; // default
+            if (empSword->has<CEnemyAI>()) {
+                empSwordDamage = empSword->get<CEnemyAI>().damage;
             }
-
-            // Destroy sword on impact
-            empSword->destroy();
-            break; // Exit player loop
+            health.takeDamage(empSwordDamage);
+            health.invulnerabilityTimer = PLAYER_HIT_INVULNERABILITY_TIME;
+            // std::cout << "[DEBUG] Player hit by emperor sword! Damage: " 
+            //         << empSwordDamage 
+            //         << " Health: " << health.currentHealth << "\n";
         }
 
-        // EmperorSword vs tile
-        for (auto& tile : m_entityManager.getEntities("tile")) {
-            if (!tile->has<CTransform>() || !tile->has<CBoundingBox>())
-                continue;
-
-            auto& tileTransform = tile->get<CTransform>();
-            auto& tileBB        = tile->get<CBoundingBox>();
-            sf::FloatRect tileRect = tileBB.getRect(tileTransform.pos);
+        // Destroy sword on impact
+        empSword->destroy();
+    }
 
-            if (!swordRect.intersects(tileRect))
-                continue;
+    // EmperorSword vs tile
+    for (auto& empSword : m_entityManager.getEntities(TagId::EmperorSword)) {
+        // Check for required components
+        if (!empSword->has<CTransform>() || !empSword->has<CBoundingBox>())
+            continue;
 
+        sf::FloatRect swordRect = empSword->getBounds();
+        if (m_tileGrid.any(swordRect)) {
             empSword->destroy();
-            break; 
         }
     }
 
     // Radial Emperor Armor sword collisions 
-    for (auto& empSword : m_entityManager.getEntities("EmperorSwordArmor")) {
-        // Check for required components
-        if (!empSword->has<CTransform>() || !empSword->has<CBoundingBox>())
+    // EmperorArmorSwordRadial vs Player
+    spentSword = nullptr;
+    for (auto& pair : m_broadphase.pairs(TagId::EmperorSwordArmor, TagId::Player)) {
+        Entity* empSword = pair.first;
+        Entity* player   = pair.second;
+        if (empSword == spentSword)
             continue;
 
-        auto& swTrans = empSword->get<CTransform>();
-        auto& swBB    = empSword->get<CBoundingBox>();
-
-        sf::FloatRect swordRect = swBB.getRect(swTrans.pos);
-        // EmperorArmorSwordRadial vs Player
-        for (auto& player : m_entityManager.getEntities("player")) {
-            if (!player->has<CTransform>() || !player->has<CBoundingBox>())
-                continue;
-
-            auto& pTrans = player->get<CTransform>();
-            auto& pBB    = player->get<CBoundingBox>();
-            sf::FloatRect playerRect = pBB.getRect(pTrans.pos);
+        if (!overlaps(pair, empSword->getBounds(), player->getBounds()))
+            continue;
 
-            if (!swordRect.intersects(playerRect))
+        // If player is defending, ignore damage
+        if (player->has<CState>()) {
+            auto& st = player->get<CState>();
+            if (st.state == "defense") {
+                //std::cout << "[DEBUG] Player in defense, ignoring Emperor sword damage.\n";
+                spentSword = empSword;
                 continue;
-
-            // If player is defending, ignore damage
-            if (player->has<CState>()) {
-                auto& st = player->get<CState>();
-                if (st.state == "defense") {
-                    //std::cout << "[DEBUG] Player in defense, ignoring Emperor sword damage.\n";
-                    break;
-                }
             }
+        }
 
-            // Damage to player
-            if (player->has<CHealth>()) {
-                auto& health = player->get<CHealth>();
-                int empSwordDamage = 1; // default
-                health.takeDamage(empSwordDamage);
-                health.invulnerabilityTimer = PLAYER_HIT_INVULNERABILITY_TIME;
-                // std::cout << "[DEBUG] Player hit by emperor sword! Damage: " 
-                //         << empSwordDamage 
-                //         << " Health: " << health.currentHealth << "\n";
-            }
+        // Damage to player
+        if (player->has<CHealth>()) {
+            auto& health = player->get<CHealth>();
+            int empSwordDamage = 1; // default
+            health.takeDamage(empSwordDamage);
+            health.invulnerabilityTimer = PLAYER_HIT_INVULNERABILITY_TIME;
+            // std::cout << "[DEBUG] Player hit by emperor sword! Damage: " 
+            //         << empSwordDamage 
+            //         << " Health: " << health.currentHealth << "\n";
         }
     }
     
     // Radial Emperor sword collisions 
-    for (auto& empSword : m_entityManager.getEntities("EmperorSwordRadial")) {
-        // Check for required components
-        if (!empSword->has<CTransform>() || !empSword->has<CBoundingBox>())
+    // EmperorSwordRadial vs Player
+    spentSword = nullptr;
+    for (auto& pair : m_broadphase.pairs(TagId::EmperorSwordRadial, TagId::Player)) {
+        Entity* empSword = pair.first;
+        Entity* player   = pair.second;
+        if (empSword == spentSword)
             continue;
 
-        auto& swTrans = empSword->get<CTransform>();
-        auto& swBB    = empSword->get<CBoundingBox>();
-
-        sf::FloatRect swordRect = swBB.getRect(swTrans.pos);
-
-        // EmperorSwordRadial vs Player
-        for (auto& player : m_entityManager.getEntities("player")) {
-            if (!player->has<CTransform>() || !player->has<CBoundingBox>())
-                continue;
+        if (!overlaps(pair, empSword->getBounds(), player->getBounds()))
+            continue;
 
-            auto& pTrans = player->get<CTransform>();
-            auto& pBB    = player->get<CBoundingBox>();
-            sf::FloatRect playerRect = pBB.getRect(pTrans.pos);
+        spentSword = empSword;
 
-            if (!swordRect.intersects(playerRect))
+        // If player is defending, ignore damage
+        if (player->has<CState>()) {
+            auto& st = player->get<CState>();
+            if (st.state == "defense") {
+                //std::cout << "[DEBUG] Player in defense, ignoring Emperor sword damage.\n";
                 continue;
-
-            // If player is defending, ignore damage
-            if (player->has<CState>()) {
-                auto& st = player->get<CState>();
-                if (st.state == "defense") {
-                    //std::cout << "[DEBUG] Player in defense, ignoring Emperor sword damage.\n";
-                    break;
-                }
             }
+        }
 
-            // Damage to player
-            if (player->has<CHealth>()) {
-                auto& health = player->get<CHealth>();
-                int empSwordDamage = 10; // default
-                if (empSword->has<CEnemyAI>()) {
-                    empSwordDamage = empSword->get<CEnemyAI>().radialAttackDamage;
-                }
-                health.takeDamage(empSwordDamage);
-                health.invulnerabilityTimer = PLAYER_HIT_INVULNERABILITY_TIME;
-                // std::cout << "[DEBUG] Player hit by emperor sword! Damage: " 
-                //         << empSwordDamage 
-                //        << " Health: " << health.currentHealth << "\n";
+        // Damage to player
+        if (player->has<CHealth>()) {
+            auto& health = player->get<CHealth>();
+            int empSwordDamage = 10; // default
+            if (empSword->has<CEnemyAI>()) {
+                empSwordDamage = empSword->get<CEnemyAI>().radialAttackDamage;
             }
-
-            // Destroy sword on impact
-            empSword->destroy();
-            break; // Exit player loop
+            health.takeDamage(empSwordDamage);
+            health.invulnerabilityTimer = PLAYER_HIT_INVULNERABILITY_TIME;
+            // std::cout << "[DEBUG] Player hit by emperor sword! Damage: " 
+            //         << empSwordDamage 
+            //        << " Health: " << health.currentHealth << "\n";
         }
 
-        // EmperorSwordRadial vs tile
-        for (auto& tile : m_entityManager.getEntities("tile")) {
-            if (!tile->has<CTransform>() || !tile->has<CBoundingBox>())
-                continue;
-
-            auto& tileTransform = tile->get<CTransform>();
-            auto& tileBB        = tile->get<CBoundingBox>();
-            sf::FloatRect tileRect = tileBB.getRect(tileTransform.pos);
+        // Destroy sword on impact
+        empSword->destroy();
+    }
 
-            if (!swordRect.intersects(tileRect))
-                continue;
+    // EmperorSwordRadial vs tile
+    for (auto& empSword : m_entityManager.getEntities(TagId::EmperorSwordRadial)) {
+        // Check for required components
+        if (!empSword->has<CTransform>() || !empSword->has<CBoundingBox>())
+            continue;
 
+        sf::FloatRect swordRect = empSword->getBounds();
+        if (m_tileGrid.any(swordRect)) {
             empSword->destroy();
-            break; 
         }
     }
 }
 
 void CollisionSystem::handlePlayerCollectibleCollisions() {
-    for (auto& player : m_entityManager.getEntities("player")) {
-        if (!player->has<CTransform>() || !player->has<CBoundingBox>())
+    for (auto& pair : m_broadphase.pairs(TagId::Player, TagId::Collectable)) {
+        Entity* player = pair.first;
+        Entity* item   = pair.second;
+        sf::FloatRect pRect = player->getBounds();
+        if (!item->has<CState>())
             continue;
-        auto& pTrans = player->get<CTransform>();
-        auto& pBB    = player->get<CBoundingBox>();
-        sf::FloatRect pRect = pBB.getRect(pTrans.pos);
-        for (auto& item : m_entityManager.getEntities("collectable")) {
-            if (!item->has<CTransform>() || !item->has<CBoundingBox>() || !item->has<CState>())
-                continue;
-            auto& iTrans = item->get<CTransform>();
-            auto& iBB    = item->get<CBoundingBox>();
-            auto& health = player->get<CHealth>();
-            
-            sf::FloatRect iRect = iBB.getRect(iTrans.pos);
+        auto& health = player->get<CHealth>();
+        
+        sf::FloatRect iRect = item->getBounds();
 
-            if (pRect.intersects(iRect)) {
-                std::string itemType = item->get<CState>().state;
-            
-                if (itemType.find("Grape") != std::string::npos) {
-                    if (itemType.find("Small") != std::string::npos) {
-                        health.heal(COLLECTIBLE_SMALL_GRAPE_POINTS);
-                    } else if (itemType.find("Big") != std::string::npos) {
-                        health.heal(COLLECTIBLE_BIG_GRAPE_HEAL);
-                    }
+        if (overlaps(pair, pRect, iRect)) {
+            const std::string& itemType = item->get<CState>().state;
+        
+            if (itemType.find("Grape") != std::string::npos) {
+                if (itemType.find("Small") != std::string::npos) {
+                    health.heal(COLLECTIBLE_SMALL_GRAPE_POINTS);
+                } else if (itemType.find("Big") != std::string::npos) {
+                    health.heal(COLLECTIBLE_BIG_GRAPE_HEAL);
                 }
-                else if (itemType.find("Coin") != std::string::npos) {
-                    if (itemType.find("Gold") != std::string::npos) {
-                        m_score += COLLECTIBLE_GOLD_COIN_POINTS;
-                    } else if (itemType.find("Silver") != std::string::npos) {
-                        m_score += COLLECTIBLE_SILVER_COIN_POINTS;
-                    } else if (itemType.find("Bronze") != std::string::npos) {
-                        m_score += COLLECTIBLE_BRONZE_COIN_POINTS;
-                    }
+            }
+            else if (itemType.find("Coin") != std::string::npos) {
+                if (itemType.find("Gold") != std::string::npos) {
+                    m_score += COLLECTIBLE_GOLD_COIN_POINTS;
+                } else if (itemType.find("Silver") != std::string::npos) {
+                    m_score += COLLECTIBLE_SILVER_COIN_POINTS;
+                } else if (itemType.find("Bronze") != std::string::npos) {
+                    m_score += COLLECTIBLE_BRONZE_COIN_POINTS;
                 }
+            }
 
-                else if (itemType.find("Chicken") != std::string::npos) {
-                    auto& playerState = player->get<CState>();
-                
-                    if (itemType.find("Small") != std::string::npos) {
-                        // Aggiunge 5 secondi alla stamina dello scudo
-                        playerState.shieldStamina += CollisionSystem::SMALLCHICKEN_POINTS;
-                        // std::cout << "[DEBUG] Player picked up ChickenSmall: +5s shield stamina.\n";
-                    } 
-                    else if (itemType.find("Big") != std::string::npos) {
-                        // Aggiunge 10 secondi alla stamina dello scudo
-                        playerState.shieldStamina += CollisionSystem::BIGCHICKEN_POINTS;
-                        // std::cout << "[DEBUG] Player picked up ChickenBig: +10s shield stamina.\n";
-                    }
-                
-                    // Se la stamina supera il limite, clamp al massimo
-                    if (playerState.shieldStamina > playerState.maxshieldStamina) {
-                        playerState.shieldStamina = playerState.maxshieldStamina;
-                    }
+            else if (itemType.find("Chicken") != std::string::npos) {
+                auto& playerState = player->get<CState>();
+            
+                if (itemType.find("Small") != std::string::npos) {
+                    // Aggiunge 5 secondi alla stamina dello scudo
+                    playerState.shieldStamina += CollisionSystem::SMALLCHICKEN_POINTS;
+                    // std::cout << "[DEBUG] Player picked up ChickenSmall: +5s shield stamina.\n";
+                } 
+                else if (itemType.find("Big") != std::string::npos) {
+                    // Aggiunge 10 secondi alla stamina dello scudo
+                    playerState.shieldStamina += CollisionSystem::BIGCHICKEN_POINTS;
+                    // std::cout << "[DEBUG] Player picked up ChickenBig: +10s shield stamina.\n";
                 }
             
-                item->destroy();
+                // Se la stamina supera il limite, clamp al massimo
+                if (playerState.shieldStamina > playerState.maxshieldStamina) {
+                    playerState.shieldStamina = playerState.maxshieldStamina;
+                }
             }
+        
+            item->destroy();
         }
     }
 }
@@ -1,17 +1,25 @@
 #pragma once
 
 #include "EntityManager.hpp"
+#include "TileGrid.hpp"
 #include "GameEngine.h"
 #include "Spawner.h"
+#include "Broadphase.h"
 #include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstdint>
+#include <utility>
 
 class CollisionSystem {
 public:
-    CollisionSystem(EntityManager& entityManager, GameEngine& game, Spawner* spawner, int& score, const std::string& levelPath);
+    CollisionSystem(EntityManager& entityManager, TileGrid& tileGrid, GameEngine& game, Spawner* spawner, int& score, const std::string& levelPath);
 
     // Game mechanics constants
     static constexpr float PLAYER_RUN_VELOCITY_THRESHOLD = 1.f;
     static constexpr float COLLISION_SEPARATION_FACTOR = 0.5f;
+    // Resolution pushes the body while it walks the tiles: query a bit wider
+    static constexpr float TILE_QUERY_MARGIN = TileGrid::CELL_SIZE * 0.5f;
+    static constexpr size_t SCRATCH_RESERVE = 256;   // per-frame buffers, reserved once
 
     // Combat constants
     static constexpr int   PLAYER_SWORD_DAMAGE = 10;
@@ -40,6 +48,7 @@ public:
 
     // Collision handling methods
     void updateCollisions();
+    void reset();
     void handlePlayerTileCollisions();
     void handleEnemyTileCollisions();
     void handlePlayerEnemyCollisions();
@@ -51,10 +60,54 @@ public:
     void handleBlackHoleTileCollisions();
     void handleMassiveBlackHoleCollisions();
 
+    const CollisionStats& stats() const { return m_stats; }
+    bool touchedLastFrame(const Entity* a, const Entity* b) const;
+
 private:
+    const std::vector<Entity*>& tilesIn(const sf::FloatRect& area, float margin = 0.f);
+    void destroyTile(Entity* tile);
+    Entity* findEnemy(const std::string& idText) const;
+    bool isSuper2(Entity* bullet) const;
+
+    bool overlaps(const Broadphase::CandidatePair& pair, const sf::FloatRect& a, const sf::FloatRect& b);
+    void warmStartGround(const Entity* body);
+    void recordGround(const Entity* body, const Entity* tile);
+    void refreshTileNames();
+
+    // Order-independent key of an entity pair (handles, so it survives the frame)
+    static uint64_t contactKey(const Entity* a, const Entity* b) {
+        uint32_t x = a->handle().value, y = b->handle().value;
+        if (x > y) std::swap(x, y);
+        return (static_cast<uint64_t>(x) << 32) | y;
+    }
+
+    struct GroundContact {
+        EntityHandle body;
+        EntityHandle tile;
+    };
+
+    struct TileNames {
+        std::string world;
+        std::string levelDoor, levelDoorGold, blackHoleBig;
+        std::string box1, box2, treasure, treasureHit;
+    };
+
     EntityManager& m_entityManager;
+    TileGrid& m_tileGrid;
     GameEngine& m_game;
     Spawner* m_spawner;
     int& m_score;
     std::string m_levelPath;
+    bool m_isEmperorRoom;
+    TileNames m_tileNames;
+    std::vector<Entity*> m_tileHits;   // tilesIn() result
+    Broadphase m_broadphase;
+    CollisionStats m_stats;
+    std::vector<Entity*> m_enemiesById;   // this frame's enemies sorted by id (findEnemy)
+
+    // Contacts kept across frames (sorted at the end of updateCollisions)
+    std::vector<uint64_t> m_contacts;
+    std::vector<uint64_t> m_lastContacts;
+    std::vector<GroundContact> m_groundContacts;       // body -> tile it landed on
+    std::vector<GroundContact> m_lastGroundContacts;
 };
@@ -11,7 +11,7 @@ DialogueSystem::DialogueSystem(GameEngine& game, EntityManager& entityManager)
       m_triggeredPositions(),
       m_currentDialogue(),
       m_currentMessageIndex(0),
-      m_portraitTexture(),
+      m_portraitTexture(game.isHeadless() ? nullptr : std::make_unique<sf::Texture>()),
       m_speakerColor(sf::Color::White),
       m_messageColor(sf::Color::White),
       m_portraitOnLeft(true),
@@ -27,9 +27,6 @@ DialogueSystem::DialogueSystem(GameEngine& game, EntityManager& entityManager)
       japaneseFontJpn(),
       m_language(game.getLanguage()),
       dialogueBox(),
-      continueText(),
-      speakerText(),
-      messageText(),
       portraitSprite()         
 {
     // Load default font
@@ -46,22 +43,9 @@ DialogueSystem::DialogueSystem(GameEngine& game, EntityManager& entityManager)
     dialogueBox.setSize(sf::Vector2f(600.f, 150.f));
     dialogueBox.setFillColor(sf::Color(0, 0, 0, 200));
 
-    // Use the appropriate font based on language
-    sf::Font& currentFont = (m_language == "Japanese") ? japaneseFontJpn : dialogueFont;
-
-    continueText.setFont(currentFont);
-    continueText.setCharacterSize(14);
-    continueText.setString((m_language == "Japanese") ? "続行するには スペースキー を押してください..." : "Press SPACE to continue...");
-
-    speakerText.setFont(currentFont);
-    speakerText.setCharacterSize(20);
-    speakerText.setFillColor(m_speakerColor);
-
-    messageText.setFont(currentFont);
-    messageText.setCharacterSize(18);
-    messageText.setFillColor(m_messageColor);
-
-    portraitSprite.setTexture(m_portraitTexture);
+    if (m_portraitTexture) {
+        portraitSprite.setTexture(*m_portraitTexture);
+    }
 
     // std::cout << "[DEBUG] DialogueSystem initialized with language: " << m_language << "\n";
 }
@@ -78,17 +62,6 @@ void DialogueSystem::setLanguage(const std::string& language)
     
     m_language = language;
     
-    // Use the appropriate font based on language
-    sf::Font& currentFont = (m_language == "Japanese") ? japaneseFontJpn : dialogueFont;
-    
-    // Update all text elements with the new font
-    continueText.setFont(currentFont);
-    speakerText.setFont(currentFont);
-    messageText.setFont(currentFont);
-    
-    // Update continue text based on language
-    continueText.setString((m_language == "Japanese") ? "続行するには スペースキー を押してください..." : "Press SPACE to continue...");
-    
     // std::cout << "[DEBUG] DialogueSystem language updated to: " << language << "\n";
 }
 
@@ -103,7 +76,7 @@ void DialogueSystem::checkTriggers()
 {
     if (m_dialogueActive) return;
 
-    auto playerEntities = m_entityManager.getEntities("player");
+    auto playerEntities = m_entityManager.getEntities(TagId::Player);
     if (playerEntities.empty()) return;
 
     auto& playerTransform = playerEntities[0]->get<CTransform>();
@@ -150,32 +123,17 @@ void DialogueSystem::startNewMessage(const DialogueMessage& message)
     dialogueBox.setPosition(message.dialogueBoxPosition);
     dialogueBox.setSize(sf::Vector2f(message.boxWidth, message.boxHeight));
 
-    continueText.setPosition(
-        dialogueBox.getPosition().x + dialogueBox.getSize().x - continueText.getLocalBounds().width - 10.f,
-        dialogueBox.getPosition().y + dialogueBox.getSize().y - continueText.getLocalBounds().height - 15.f
-    );
-    if (!message.portraitPath.empty() && !m_portraitTexture.loadFromFile(message.portraitPath)) {
-        std::cerr << "[WARNING] Could not load portrait: " << message.portraitPath << "\n";
+    if (m_portraitTexture) {
+        if (!message.portraitPath.empty() && !m_portraitTexture->loadFromFile(message.portraitPath)) {
+            std::cerr << "[WARNING] Could not load portrait: " << message.portraitPath << "\n";
+        }
+        portraitSprite.setTexture(*m_portraitTexture);
     }
-    portraitSprite.setTexture(m_portraitTexture);
 
     m_speakerColor = message.speakerColor;
     m_messageColor = message.messageColor;
     m_portraitOnLeft = message.portraitOnLeft;
 
-    // Use the appropriate font based on language
-    sf::Font& currentFont = (m_language == "Japanese") ? japaneseFontJpn : dialogueFont;
-    speakerText.setFont(currentFont);
-    messageText.setFont(currentFont);
-
-    messageText.setCharacterSize(message.messageFontSize);
-
-    speakerText.setFillColor(m_speakerColor);
-    messageText.setFillColor(m_messageColor);
-
-    speakerText.setString(message.speaker);
-    messageText.setString(m_displayedText);
-
     // std::cout << "[DEBUG] Started new message from " << message.speaker << "\n";
 }
 
@@ -203,9 +161,6 @@ void DialogueSystem::updateTypewriterEffect(float deltaTime)
     } else {
         m_displayedText = currentMessage.message.substr(0, charCount);
     }
-
-    speakerText.setString(currentMessage.speaker);
-    messageText.setString(m_displayedText);
 }
 
 void DialogueSystem::advanceDialogue()
@@ -246,7 +201,7 @@ const std::string& DialogueSystem::getDisplayedText() const { return m_displayed
 bool DialogueSystem::isTyping() const { return m_isTyping; }
 bool DialogueSystem::isWaitingAfterCompletion() const { return m_waitingAfterCompletion; }
 float DialogueSystem::getCompletionTimer() const { return m_completionTimer; }
-const sf::Texture& DialogueSystem::getPortraitTexture() const { return m_portraitTexture; }
+const sf::Texture& DialogueSystem::getPortraitTexture() const { return *m_portraitTexture; }
 
 void DialogueSystem::update(float deltaTime)
 {
@@ -266,7 +221,7 @@ void DialogueSystem::update(float deltaTime)
                 m_dialogueActive = false;
                 m_waitingAfterCompletion = false;
 
-                auto playerEntities = m_entityManager.getEntities("player");
+                auto playerEntities = m_entityManager.getEntities(TagId::Player);
                 if (!playerEntities.empty()) {
                     auto player = playerEntities[0];
                     if (player->has<CState>() && player->has<CTransform>()) {
@@ -277,42 +232,22 @@ void DialogueSystem::update(float deltaTime)
             }
         }
 
-        // Get current message explicitly and update rendering positions/colors each frame
+        // Get current message explicitly and update the box and portrait each frame
+        // (the texts are laid out by PlayRenderer::renderDialogue)
         const DialogueMessage* currentMessage = getCurrentMessage();
         if (currentMessage) {
-            // Use the appropriate font based on language
-            sf::Font& currentFont = (m_language == "Japanese") ? japaneseFontJpn : dialogueFont;
-            speakerText.setFont(currentFont);
-            messageText.setFont(currentFont);
-            continueText.setFont(currentFont);
-
             dialogueBox.setPosition(currentMessage->dialogueBoxPosition);
             dialogueBox.setSize(sf::Vector2f(currentMessage->boxWidth, currentMessage->boxHeight));
 
-            // Update colors and font sizes explicitly per frame
-            speakerText.setFillColor(currentMessage->speakerColor);
-            messageText.setFillColor(currentMessage->messageColor);
-            speakerText.setCharacterSize(24); // Fixed size for speaker
-            messageText.setCharacterSize(currentMessage->messageFontSize);
-
             // Update portrait position explicitly
             if (currentMessage->portraitOnLeft) {
                 portraitSprite.setPosition(dialogueBox.getPosition().x + 10.f, dialogueBox.getPosition().y + 10.f);
-                speakerText.setPosition(dialogueBox.getPosition().x + 150.f, dialogueBox.getPosition().y + 10.f);
-                messageText.setPosition(dialogueBox.getPosition().x + 150.f, dialogueBox.getPosition().y + 40.f);
             } else {
                 portraitSprite.setPosition(
                     dialogueBox.getPosition().x + dialogueBox.getSize().x - portraitSprite.getGlobalBounds().width - 10.f,
                     dialogueBox.getPosition().y + 10.f
                 );
-                speakerText.setPosition(dialogueBox.getPosition().x + 10.f, dialogueBox.getPosition().y + 10.f);
-                messageText.setPosition(dialogueBox.getPosition().x + 10.f, dialogueBox.getPosition().y + 40.f);
             }
-
-            continueText.setPosition(
-                dialogueBox.getPosition().x + dialogueBox.getSize().x - continueText.getLocalBounds().width - 10.f,
-                dialogueBox.getPosition().y + dialogueBox.getSize().y - continueText.getLocalBounds().height - 15.f
-            );
         }
     }
 }
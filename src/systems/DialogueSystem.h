@@ -4,6 +4,7 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <memory>
 #include "EntityManager.hpp"
 #include "GameEngine.h"
 
@@ -31,7 +32,7 @@ private:
     std::map<std::string, std::vector<DialogueMessage>> m_namedDialogues;
     std::vector<DialogueMessage> m_currentDialogue;
     size_t m_currentMessageIndex;
-    sf::Texture m_portraitTexture;
+    std::unique_ptr<sf::Texture> m_portraitTexture;   // null when headless (nothing is drawn)
     sf::Color m_speakerColor;
     sf::Color m_messageColor;
     bool m_portraitOnLeft;
@@ -52,9 +53,6 @@ private:
 public:
     // UI elements - keeping these public to maintain compatibility with PlayRenderer
     sf::RectangleShape dialogueBox;
-    sf::Text continueText;
-    sf::Text speakerText;
-    sf::Text messageText;
     sf::Sprite portraitSprite;
     
     DialogueSystem(GameEngine& game, EntityManager& entityManager);
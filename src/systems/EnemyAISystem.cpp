@@ -6,60 +6,13 @@
 #include <iostream>
 #include <limits>
 
-// Utility Functions 
-
-static bool segmentsIntersect(const Vec2<float>& p1, const Vec2<float>& p2,
-                              const Vec2<float>& q1, const Vec2<float>& q2)
-{
-    auto orientation = [](const Vec2<float>& a, const Vec2<float>& b, const Vec2<float>& c) -> float {
-        return (b.y - a.y) * (c.x - b.x) - (b.x - a.x) * (c.y - b.y);
-    };
-
-    float o1 = orientation(p1, p2, q1);
-    float o2 = orientation(p1, p2, q2);
-    float o3 = orientation(q1, q2, p1);
-    float o4 = orientation(q1, q2, p2);
-
-    return (o1 * o2 < 0 && o3 * o4 < 0);
-}
-
-static bool lineIntersectsRect(const Vec2<float>& start,
-                               const Vec2<float>& end,
-                               const sf::FloatRect& rect)
-{
-    Vec2<float> topLeft  { rect.left,               rect.top };
-    Vec2<float> topRight { rect.left + rect.width,  rect.top };
-    Vec2<float> botRight { rect.left + rect.width,  rect.top + rect.height };
-    Vec2<float> botLeft  { rect.left,               rect.top + rect.height };
-
-    return (segmentsIntersect(start, end, topLeft, topRight) ||
-            segmentsIntersect(start, end, topRight, botRight) ||
-            segmentsIntersect(start, end, botRight, botLeft) ||
-            segmentsIntersect(start, end, botLeft, topLeft));
-}
-
-bool checkLineOfSight(const Vec2<float>& enemyCenter,
-                      const Vec2<float>& playerCenter,
-                      EntityManager& entityManager)
-{
-    for (auto& tile : entityManager.getEntities("tile")) {
-        if (!tile->has<CTransform>() || !tile->has<CBoundingBox>()) continue;
-        auto& tileTrans = tile->get<CTransform>();
-        auto& tileBB    = tile->get<CBoundingBox>();
-
-        sf::FloatRect tileRect = tileBB.getRect(tileTrans.pos);
-        if (lineIntersectsRect(enemyCenter, playerCenter, tileRect)) {
-            return false;
-        }
-    }
-    return true;
-}
-
 // EnemyAISystem Implementation
 EnemyAISystem::EnemyAISystem(EntityManager& entityManager,
+                             const TileGrid& tileGrid,
                              Spawner& spawner,
                              GameEngine& game)
     : m_entityManager(entityManager),
+      m_tileGrid(tileGrid),
       m_spawner(&spawner),
       m_game(game)
 {
@@ -70,10 +23,10 @@ EnemyAISystem::EnemyAISystem(EntityManager& entityManager,
 void EnemyAISystem::update(float deltaTime)
 {
     // Early checks: No enemies or players -> Nothing to do
-    auto enemies = m_entityManager.getEntities("enemy");
+    auto enemies = m_entityManager.getEntities(TagId::Enemy);
     if (enemies.empty()) return;
 
-    auto players = m_entityManager.getEntities("player");
+    auto players = m_entityManager.getEntities(TagId::Player);
     if (players.empty()) return;
 
     auto& player      = players[0];
@@ -82,9 +35,18 @@ void EnemyAISystem::update(float deltaTime)
 
     updateCitizens(deltaTime, playerTrans);
 
+    // Line of sight to the player for every enemy at once, from this frame's
+    // starting positions (indexed like `enemies`)
+    m_sightOrigins.clear();
+    for (auto& enemy : enemies) {
+        m_sightOrigins.push_back(enemy->has<CTransform>() ? enemy->get<CTransform>().pos : playerTrans.pos);
+    }
+    m_tileGrid.lineOfSight(playerTrans.pos, m_sightOrigins, m_seesPlayer);
+
 
     // Loop through all enemies
     for (auto& enemy : enemies) {
+        const bool seesPlayer = m_seesPlayer[&enemy - enemies.data()] != 0;
         // Must have these components or skip
         if (!enemy->has<CTransform>() ||
             !enemy->has<CEnemyAI>()  ||
@@ -122,7 +84,7 @@ void EnemyAISystem::update(float deltaTime)
                 }
                 
                 // Find citizens in attack range
-                for (auto& citizen : m_entityManager.getEntities("enemy")) {
+                for (auto& citizen : m_entityManager.getEntities(TagId::Enemy)) {
                     if (!citizen->has<CEnemyAI>() || 
                         citizen->get<CEnemyAI>().enemyType != EnemyType::Citizen) {
                         continue;
@@ -315,12 +277,12 @@ void EnemyAISystem::update(float deltaTime)
                         
                         // Get player position
                         Vec2<float> playerPos;
-                        auto players = m_entityManager.getEntities("player");
+                        auto players = m_entityManager.getEntities(TagId::Player);
                         if (!players.empty() && players[0]->has<CTransform>()) {
                             playerPos = players[0]->get<CTransform>().pos;
                         } else {
-                            playerPos = Vec2<float>(m_game.window().getSize().x * 0.5f, 
-                                                m_game.window().getSize().y * 0.5f);
+                            playerPos = Vec2<float>(m_game.windowSize().x * 0.5f, 
+                                                m_game.windowSize().y * 0.5f);
                         }
                         
                         // Calculate direction to player
@@ -337,7 +299,7 @@ void EnemyAISystem::update(float deltaTime)
                         std::string animName = "AlienBlackHoleRedBig";
                         if (m_game.assets().hasAnimation(animName)) {
                             // Create massive black hole
-                            auto massiveBlackHole = m_entityManager.addEntity("emperorBlackHole");
+                            auto massiveBlackHole = m_entityManager.addEntity(TagId::EmperorBlackHole);
                             massiveBlackHole->add<CTransform>(enemyTrans.pos);
                             massiveBlackHole->add<CLifeSpan>(16.0f);
                             massiveBlackHole->add<CState>(std::to_string(enemy->id()));
@@ -452,7 +414,7 @@ void EnemyAISystem::update(float deltaTime)
                         
                         if (enemyAI.burstCount >= 12) {
                             // Clear all projectiles
-                            auto enemySwords = m_entityManager.getEntities("EmperorSword");
+                            auto enemySwords = m_entityManager.getEntities(TagId::EmperorSword);
                             for (auto& sword : enemySwords) {
                                 sword->destroy();
                             }
@@ -504,7 +466,7 @@ void EnemyAISystem::update(float deltaTime)
             
             // Prevent falling below a certain height
             const float MIN_HEIGHT = 100.f; // Minimum height from the bottom of the screen
-            float groundLevel = m_game.window().getSize().y - MIN_HEIGHT;
+            float groundLevel = m_game.windowSize().y - MIN_HEIGHT;
             
             // If Emperor is falling below minimum height, push back up
             if (enemyTrans.pos.y > groundLevel) {
@@ -688,7 +650,7 @@ void EnemyAISystem::update(float deltaTime)
                                 
                                 // Spawn bullet going right (0 degrees)
                                 {
-                                    auto bullet = m_entityManager.addEntity("enemyBullet");
+                                    auto bullet = m_entityManager.addEntity(TagId::EnemyBullet);
                                     bullet->add<CTransform>(eTrans.pos);
                                     bullet->add<CLifeSpan>(8.0f);
                                     bullet->add<CState>(std::to_string(enemy->id()));
@@ -709,7 +671,7 @@ void EnemyAISystem::update(float deltaTime)
                                 
                                 // Spawn bullet going left (180 degrees)
                                 {
-                                    auto bullet = m_entityManager.addEntity("enemyBullet");
+                                    auto bullet = m_entityManager.addEntity(TagId::EnemyBullet);
                                     bullet->add<CTransform>(eTrans.pos);
                                     bullet->add<CLifeSpan>(8.0f);
                                     bullet->add<CState>(std::to_string(enemy->id()));
@@ -751,12 +713,12 @@ void EnemyAISystem::update(float deltaTime)
                             
                             // Get player position
                             Vec2<float> playerPos;
-                            auto players = m_entityManager.getEntities("player");
+                            auto players = m_entityManager.getEntities(TagId::Player);
                             if (!players.empty() && players[0]->has<CTransform>()) {
                                 playerPos = players[0]->get<CTransform>().pos;
                             } else {
-                                playerPos = Vec2<float>(m_game.window().getSize().x * 0.5f, 
-                                                    m_game.window().getSize().y * 0.5f);
+                                playerPos = Vec2<float>(m_game.windowSize().x * 0.5f, 
+                                                    m_game.windowSize().y * 0.5f);
                             }
                             
                             // Calculate direction to player
@@ -773,7 +735,7 @@ void EnemyAISystem::update(float deltaTime)
                             // Spawn 2 black holes with slight angle variation
                             for (int i = 0; i < 2; i++) {
                                 // Create a slight angle variation for each black hole (±15 degrees)
-                                float angleVariation = (std::rand() % 31 - 15) * 3.1415926535f / 180.f;
+                                float angleVariation = (m_game.random().below(31) - 15) * 3.1415926535f / 180.f;
                                 float cosAngle = std::cos(angleVariation);
                                 float sinAngle = std::sin(angleVariation);
                                 
@@ -783,7 +745,7 @@ void EnemyAISystem::update(float deltaTime)
                                 direction.y = baseDirection.x * sinAngle + baseDirection.y * cosAngle;
                                 
                                 // Create black hole entity
-                                auto blackHole = m_entityManager.addEntity("emperorBlackHole");
+                                auto blackHole = m_entityManager.addEntity(TagId::EmperorBlackHole);
                                 blackHole->add<CTransform>(eTrans.pos);
                                 blackHole->add<CLifeSpan>(5.0f);
                                 blackHole->add<CState>(std::to_string(enemy->id()));
@@ -825,12 +787,12 @@ void EnemyAISystem::update(float deltaTime)
                             
                             // Get player position
                             Vec2<float> playerPos;
-                            auto players = m_entityManager.getEntities("player");
+                            auto players = m_entityManager.getEntities(TagId::Player);
                             if (!players.empty() && players[0]->has<CTransform>()) {
                                 playerPos = players[0]->get<CTransform>().pos;
                             } else {
-                                playerPos = Vec2<float>(m_game.window().getSize().x * 0.5f, 
-                                                    m_game.window().getSize().y * 0.5f);
+                                playerPos = Vec2<float>(m_game.windowSize().x * 0.5f, 
+                                                    m_game.windowSize().y * 0.5f);
                             }
                             
                             // Calculate direction to player
@@ -848,7 +810,7 @@ void EnemyAISystem::update(float deltaTime)
                             std::string animName = "AlienBlackHoleAttack";
                             if (m_game.assets().hasAnimation(animName)) {
                                 // Create big black hole (not as big as massive)
-                                auto bigBlackHole = m_entityManager.addEntity("emperorBlackHole");
+                                auto bigBlackHole = m_entityManager.addEntity(TagId::EmperorBlackHole);
                                 bigBlackHole->add<CTransform>(enemyTrans.pos);
                                 bigBlackHole->add<CLifeSpan>(10.0f);
                                 bigBlackHole->add<CState>(std::to_string(enemy->id()));
@@ -890,15 +852,15 @@ void EnemyAISystem::update(float deltaTime)
                             auto& enemyTrans = enemy->get<CTransform>();
                             
                             // 50% chance to spawn a big black hole toward player
-                            if (std::rand() % 2 == 0) {
+                            if (m_game.random().below(2) == 0) {
                                 // Get player position
                                 Vec2<float> playerPos;
-                                auto players = m_entityManager.getEntities("player");
+                                auto players = m_entityManager.getEntities(TagId::Player);
                                 if (!players.empty() && players[0]->has<CTransform>()) {
                                     playerPos = players[0]->get<CTransform>().pos;
                                 } else {
-                                    playerPos = Vec2<float>(m_game.window().getSize().x * 0.5f, 
-                                                        m_game.window().getSize().y * 0.5f);
+                                    playerPos = Vec2<float>(m_game.windowSize().x * 0.5f, 
+                                                        m_game.windowSize().y * 0.5f);
                                 }
                                 
                                 // Calculate direction to player
@@ -914,7 +876,7 @@ void EnemyAISystem::update(float deltaTime)
                                 // Spawn big black hole aimed at player
                                 std::string animName = "AlienBlackHoleAttack";
                                 if (m_game.assets().hasAnimation(animName)) {
-                                    auto bigBlackHole = m_entityManager.addEntity("emperorBlackHole");
+                                    auto bigBlackHole = m_entityManager.addEntity(TagId::EmperorBlackHole);
                                     bigBlackHole->add<CTransform>(enemyTrans.pos);
                                     bigBlackHole->add<CLifeSpan>(10.0f);
                                     bigBlackHole->add<CState>(std::to_string(enemy->id()));
@@ -943,13 +905,13 @@ void EnemyAISystem::update(float deltaTime)
                                 // Spawn 3 small black holes in random directions
                                 for (int i = 0; i < 3; i++) {
                                     // Random angle
-                                    float angle = (std::rand() % 360) * 3.1415926535f / 180.f;
+                                    float angle = m_game.random().below(360) * 3.1415926535f / 180.f;
                                     
                                     // Direction based on random angle
                                     Vec2<float> direction(std::cos(angle), std::sin(angle));
                                     
                                     // Create small black hole entity
-                                    auto blackHole = m_entityManager.addEntity("emperorBlackHole");
+                                    auto blackHole = m_entityManager.addEntity(TagId::EmperorBlackHole);
                                     blackHole->add<CTransform>(enemyTrans.pos);
                                     blackHole->add<CLifeSpan>(5.0f);
                                     blackHole->add<CState>(std::to_string(enemy->id()));
@@ -1064,7 +1026,7 @@ void EnemyAISystem::update(float deltaTime)
             //           << " timer=" << enemyAI.knockbackTimer << "\n";
 
             // Destroy associated swords
-            auto enemySwords = m_entityManager.getEntities("enemySword");
+            auto enemySwords = m_entityManager.getEntities(TagId::EnemySword);
             for (auto& sword : enemySwords) {
                 if (sword->has<CState>()) {
                     auto& swordState = sword->get<CState>();
@@ -1091,17 +1053,7 @@ void EnemyAISystem::update(float deltaTime)
             auto& bb = enemy->get<CBoundingBox>();
             sf::FloatRect enemyRect = bb.getRect(enemyTrans.pos);
 
-            for (auto& tile : m_entityManager.getEntities("tile")) {
-                if (!tile->has<CTransform>() || !tile->has<CBoundingBox>()) continue;
-                auto& tileTrans = tile->get<CTransform>();
-                auto& tileBB    = tile->get<CBoundingBox>();
-
-                sf::FloatRect tileRect = tileBB.getRect(tileTrans.pos);
-                if (enemyRect.intersects(tileRect)) {
-                    isOnGround = true;
-                    break;
-                }
-            }
+            isOnGround = m_tileGrid.any(enemyRect);
         }
         if (!isOnGround) {
             float grav = enemy->has<CGravity>()
@@ -1128,9 +1080,7 @@ void EnemyAISystem::update(float deltaTime)
             continue; // Skip further logic
         }
 
-        bool canSeePlayer = checkLineOfSight(enemyTrans.pos,
-                                             playerTrans.pos,
-                                             m_entityManager);
+        bool canSeePlayer = seesPlayer;
 
         bool playerVisible       = (distance < PLAYER_VISIBLE_DISTANCE) || ((distance < PLAYER_VISIBLE_DISTANCE * 1.5) && canSeePlayer);
 
@@ -1188,8 +1138,10 @@ void EnemyAISystem::update(float deltaTime)
                                 ? enemyRect.left + enemyRect.width
                                 : enemyRect.left;
         
-            // Check for tile in front
-            for (auto& tile : m_entityManager.getEntities("tile")) {
+            // Check for tile in front (a front tile touches the enemy's rect)
+            sf::FloatRect frontArea(enemyRect.left - 1.f, enemyRect.top, enemyRect.width + 2.f, enemyRect.height);
+            m_tileGrid.query(frontArea, m_tileHits);
+            for (auto& tile : m_tileHits) {
                 if (!tile->has<CTransform>() || !tile->has<CBoundingBox>() || !tile->has<CAnimation>())
                     continue;
         
@@ -1239,8 +1191,10 @@ void EnemyAISystem::update(float deltaTime)
                                     ? enemyRect.left + enemyRect.width
                                     : enemyRect.left;
                 
-                // Check for tile in front
-                for (auto& tile : m_entityManager.getEntities("tile")) {
+                // Check for tile in front (a front tile touches the enemy's rect)
+                sf::FloatRect frontArea(enemyRect.left - 1.f, enemyRect.top, enemyRect.width + 2.f, enemyRect.height);
+                m_tileGrid.query(frontArea, m_tileHits);
+                for (auto& tile : m_tileHits) {
                     if (!tile->has<CTransform>() || !tile->has<CBoundingBox>() || !tile->has<CAnimation>())
                         continue;
                 
@@ -1321,9 +1275,7 @@ void EnemyAISystem::update(float deltaTime)
                 enemyAI.facingDirection = (dx > 0.f) ? 1.f : -1.f;
                 
                 // Check if we can see the player (for ranged attacks)
-                bool hasLineOfSight = checkLineOfSight(enemyTrans.pos, 
-                                                    playerTrans.pos, 
-                                                    m_entityManager);
+                bool hasLineOfSight = seesPlayer;
                 
                 // Decide how to move based on horizontal distance only
                 float horizontalDistance = std::abs(dx);
@@ -1510,9 +1462,7 @@ void EnemyAISystem::update(float deltaTime)
             if (!skipShooting) {
                 // (B) If not bursting
                 if (!enemyAI.inBurst) {
-                    bool canShoot = checkLineOfSight(enemyTrans.pos,
-                                                playerTrans.pos,
-                                                m_entityManager)
+                    bool canShoot = seesPlayer
                                     && (distance >= enemyAI.minShootDistance)
                                     && (distance <= enemyAI.maxShootDistance);
                     if (enemyAI.superMoveReady && canShoot) {
@@ -1594,7 +1544,7 @@ void EnemyAISystem::update(float deltaTime)
                         // Slight random angle for all enemies
                         if (bullet && bullet->has<CTransform>()) {
                             auto& bulletTrans = bullet->get<CTransform>();
-                            float angleOffset = -3.f + static_cast<float>(rand() % 6);
+                            float angleOffset = -3.f + static_cast<float>(m_game.random().below(6));
                             bulletTrans.rotate(angleOffset);
                         }
 
@@ -1780,8 +1730,8 @@ void EnemyAISystem::update(float deltaTime)
 }
 void EnemyAISystem::updateCitizens(float deltaTime, const CTransform& playerTrans)
 {
-    auto enemies = m_entityManager.getEntities("enemy");
-    auto superEnemies = m_entityManager.getEntities("superEnemy");
+    auto enemies = m_entityManager.getEntities(TagId::Enemy);
+    auto superEnemies = m_entityManager.getEntities(TagId::SuperEnemy);
 
     
     // Constants specifically for citizen behavior
@@ -1818,7 +1768,7 @@ void EnemyAISystem::updateCitizens(float deltaTime, const CTransform& playerTran
             sf::FloatRect citizenRect = citizenBB.getRect(enemyTrans.pos);
             
             // Check collisions with super enemies
-            for (auto& superEnemy : m_entityManager.getEntities("enemy")) {
+            for (auto& superEnemy : m_entityManager.getEntities(TagId::Enemy)) {
                 // Only consider Super type enemies
                 if (!superEnemy->has<CEnemyAI>() || 
                     superEnemy->get<CEnemyAI>().enemyType != EnemyType::Super) {
@@ -1859,17 +1809,7 @@ void EnemyAISystem::updateCitizens(float deltaTime, const CTransform& playerTran
             auto& bb = enemy->get<CBoundingBox>();
             sf::FloatRect enemyRect = bb.getRect(enemyTrans.pos);
 
-            for (auto& tile : m_entityManager.getEntities("tile")) {
-                if (!tile->has<CTransform>() || !tile->has<CBoundingBox>()) continue;
-                auto& tileTrans = tile->get<CTransform>();
-                auto& tileBB = tile->get<CBoundingBox>();
-
-                sf::FloatRect tileRect = tileBB.getRect(tileTrans.pos);
-                if (enemyRect.intersects(tileRect)) {
-                    isOnGround = true;
-                    break;
-                }
-            }
+            isOnGround = m_tileGrid.any(enemyRect);
         }
         
         if (!isOnGround) {
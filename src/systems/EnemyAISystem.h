@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EntityManager.hpp"
+#include "TileGrid.hpp"
 #include "Spawner.h"
 #include "GameEngine.h"
 #include "systems/DialogueSystem.h"
@@ -8,7 +9,7 @@
 class EnemyAISystem {
 public:
     // Updated constructor declaration with GameEngine parameter
-    EnemyAISystem(EntityManager& entityManager, Spawner& spawner, GameEngine& game);
+    EnemyAISystem(EntityManager& entityManager, const TileGrid& tileGrid, Spawner& spawner, GameEngine& game);
 
     static constexpr float MAX_FALL_SPEED = 600.f;
     static constexpr float KNOCKBACK_DECAY_FACTOR = 0.99f;
@@ -40,6 +41,10 @@ public:
 
 private:
     EntityManager& m_entityManager;
+    const TileGrid& m_tileGrid;
+    std::vector<Entity*> m_tileHits;   // tile-in-front query buffer
+    std::vector<Vec2<float>> m_sightOrigins;   // enemy positions for the batched raycast
+    std::vector<uint8_t> m_seesPlayer;         // per enemy, same order
     Spawner* m_spawner;
     GameEngine& m_game; 
     std::shared_ptr<DialogueSystem> m_dialogueSystem;
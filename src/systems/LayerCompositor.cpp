@@ -0,0 +1,206 @@
+#include "LayerCompositor.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+LayerCompositor::LayerCompositor(std::vector<StaticBatch*> layers)
+    : m_layers(std::move(layers))
+{
+}
+
+void LayerCompositor::update() {
+    m_rects.clear();
+    bool rebuilt = false;
+    for (StaticBatch* layer : m_layers) {
+        rebuilt |= layer->takeChanges(m_rects);
+    }
+    if (m_direct) return;
+
+    // A rebuilt batch is a new level: start over. Otherwise only the chunks
+    // under the changes are redrawn
+    if (rebuilt || (m_chunks.empty() && !m_rects.empty())) {
+        regrid();
+        return;
+    }
+    for (const sf::FloatRect& rect : m_rects) {
+        if (!markDirty(rect)) {   // outside the level (a spawned tile): grow to it
+            extend(rect);
+            markDirty(rect);
+        }
+    }
+}
+
+void LayerCompositor::regrid() {
+    for (Chunk& chunk : m_chunks) {
+        if (chunk.cache != NO_CACHE) m_freeCaches.push_back(chunk.cache);
+    }
+    m_chunks.clear();
+    m_columns = 0;
+    m_rows = 0;
+
+    m_rects.clear();
+    for (const StaticBatch* layer : m_layers) {
+        layer->coverage(m_rects);
+    }
+    if (m_rects.empty()) return;
+
+    float minX = std::numeric_limits<float>::max(), minY = minX;
+    float maxX = std::numeric_limits<float>::lowest(), maxY = maxX;
+    for (const sf::FloatRect& rect : m_rects) {
+        minX = std::min(minX, rect.left);
+        minY = std::min(minY, rect.top);
+        maxX = std::max(maxX, rect.left + rect.width);
+        maxY = std::max(maxY, rect.top + rect.height);
+    }
+
+    // Origin on the tile grid, like TileGrid's
+    m_origin.x = std::floor(minX / TileGrid::CELL_SIZE) * TileGrid::CELL_SIZE;
+    m_origin.y = std::floor(minY / TileGrid::CELL_SIZE) * TileGrid::CELL_SIZE;
+    m_columns  = static_cast<int>(std::floor((maxX - m_origin.x) / CHUNK_SIZE)) + 1;
+    m_rows     = static_cast<int>(std::floor((maxY - m_origin.y) / CHUNK_SIZE)) + 1;
+    m_chunks.assign(static_cast<size_t>(m_columns) * m_rows, Chunk());
+
+    // Empty chunks (sky, gaps) never get a texture
+    for (const sf::FloatRect& rect : m_rects) {
+        markDirty(rect);
+    }
+}
+
+// Adds whole chunks around the grid until it covers `rect`: the existing
+// chunks keep their place in the world, and their cached textures
+void LayerCompositor::extend(const sf::FloatRect& rect) {
+    int addLeft   = std::max(0, static_cast<int>(std::ceil((m_origin.x - rect.left) / CHUNK_SIZE)));
+    int addTop    = std::max(0, static_cast<int>(std::ceil((m_origin.y - rect.top) / CHUNK_SIZE)));
+    int addRight  = std::max(0, static_cast<int>(std::floor((rect.left + rect.width - m_origin.x) / CHUNK_SIZE)) + 1 - m_columns);
+    int addBottom = std::max(0, static_cast<int>(std::floor((rect.top + rect.height - m_origin.y) / CHUNK_SIZE)) + 1 - m_rows);
+
+    int columns = m_columns + addLeft + addRight;
+    int rows    = m_rows + addTop + addBottom;
+    std::vector<Chunk> chunks(static_cast<size_t>(columns) * rows);
+    for (int row = 0; row < m_rows; ++row) {
+        for (int column = 0; column < m_columns; ++column) {
+            chunks[static_cast<size_t>(row + addTop) * columns + column + addLeft] =
+                m_chunks[static_cast<size_t>(row) * m_columns + column];
+        }
+    }
+
+    m_chunks  = std::move(chunks);
+    m_columns = columns;
+    m_rows    = rows;
+    m_origin.x -= addLeft * CHUNK_SIZE;
+    m_origin.y -= addTop * CHUNK_SIZE;
+}
+
+bool LayerCompositor::markDirty(const sf::FloatRect& rect) {
+    int firstColumn = static_cast<int>(std::floor((rect.left - m_origin.x) / CHUNK_SIZE));
+    int firstRow    = static_cast<int>(std::floor((rect.top - m_origin.y) / CHUNK_SIZE));
+    int lastColumn  = static_cast<int>(std::floor((rect.left + rect.width - m_origin.x) / CHUNK_SIZE));
+    int lastRow     = static_cast<int>(std::floor((rect.top + rect.height - m_origin.y) / CHUNK_SIZE));
+    if (firstColumn < 0 || firstRow < 0 || lastColumn >= m_columns || lastRow >= m_rows) {
+        return false;
+    }
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            Chunk& chunk = m_chunks[static_cast<size_t>(row) * m_columns + column];
+            chunk.occupied = true;
+            chunk.dirty = true;
+        }
+    }
+    return true;
+}
+
+sf::FloatRect LayerCompositor::chunkRect(int column, int row) const {
+    return sf::FloatRect(m_origin.x + column * CHUNK_SIZE, m_origin.y + row * CHUNK_SIZE,
+                         CHUNK_SIZE, CHUNK_SIZE);
+}
+
+int LayerCompositor::acquireCache() {
+    if (!m_freeCaches.empty()) {
+        int cache = m_freeCaches.back();
+        m_freeCaches.pop_back();
+        return cache;
+    }
+
+    const unsigned int size = static_cast<unsigned int>(CHUNK_SIZE);
+    auto cache = std::make_unique<sf::RenderTexture>();
+    if (size > sf::Texture::getMaximumSize() || !cache->create(size, size)) {
+        std::cerr << "[WARNING] Could not create a " << size << "x" << size
+                  << " render texture, drawing the static layers directly\n";
+        m_direct = true;
+        return NO_CACHE;
+    }
+    m_caches.push_back(std::move(cache));
+    return static_cast<int>(m_caches.size()) - 1;
+}
+
+void LayerCompositor::redraw(Chunk& chunk, int column, int row, RenderStats& stats) {
+    sf::RenderTexture& cache = *m_caches[chunk.cache];
+    sf::FloatRect rect = chunkRect(column, row);
+    cache.setView(sf::View(rect));
+    cache.clear(sf::Color::Transparent);
+
+    // Only the draw calls count; drawn/culled are about what reaches the screen
+    RenderStats layerStats;
+    DrawList cacheTarget(cache);
+    for (const StaticBatch* layer : m_layers) {
+        layer->draw(cacheTarget, rect, layerStats);
+    }
+    cache.display();
+
+    stats.batchCalls += layerStats.batchCalls;
+    ++stats.chunkRedraws;
+    chunk.dirty = false;
+}
+
+void LayerCompositor::draw(DrawList& target, const sf::FloatRect& area, RenderStats& stats) {
+    if (!m_direct && !m_chunks.empty()) {
+        int firstColumn = std::max(0, static_cast<int>(std::floor((area.left - m_origin.x) / CHUNK_SIZE)));
+        int firstRow    = std::max(0, static_cast<int>(std::floor((area.top - m_origin.y) / CHUNK_SIZE)));
+        int lastColumn  = std::min(m_columns - 1,
+                                   static_cast<int>(std::floor((area.left + area.width - m_origin.x) / CHUNK_SIZE)));
+        int lastRow     = std::min(m_rows - 1,
+                                   static_cast<int>(std::floor((area.top + area.height - m_origin.y) / CHUNK_SIZE)));
+
+        // Chunks that scrolled away give their texture back
+        for (int row = 0; row < m_rows; ++row) {
+            for (int column = 0; column < m_columns; ++column) {
+                Chunk& chunk = m_chunks[static_cast<size_t>(row) * m_columns + column];
+                if (chunk.cache == NO_CACHE) continue;
+                if (column >= firstColumn && column <= lastColumn && row >= firstRow && row <= lastRow) continue;
+                m_freeCaches.push_back(chunk.cache);
+                chunk.cache = NO_CACHE;
+                chunk.dirty = true;
+            }
+        }
+
+        // The textures hold premultiplied colour (drawn with alpha blending
+        // over transparent), so they are composited with One/OneMinusSrcAlpha
+        sf::RenderStates states(sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha));
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                Chunk& chunk = m_chunks[static_cast<size_t>(row) * m_columns + column];
+                if (!chunk.occupied) continue;
+                if (chunk.cache == NO_CACHE) {
+                    chunk.cache = acquireCache();
+                    chunk.dirty = true;
+                    if (chunk.cache == NO_CACHE) break;   // m_direct is now set
+                }
+                if (chunk.dirty) redraw(chunk, column, row, stats);
+
+                sf::FloatRect rect = chunkRect(column, row);
+                sf::Sprite sprite(m_caches[chunk.cache]->getTexture());
+                sprite.setPosition(rect.left, rect.top);
+                target.draw(sprite, states);
+                ++stats.chunksComposited;
+            }
+            if (m_direct) break;
+        }
+        if (!m_direct) return;
+    }
+
+    for (const StaticBatch* layer : m_layers) {
+        layer->draw(target, area, stats);
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "StaticBatch.h"
+#include "TileGrid.hpp"
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+// Caches the static layers (decorations, then tiles) in offscreen
+// RenderTextures. The level is cut into CHUNK_SIZE squares aligned to the tile
+// grid; a chunk under the view is rendered once into its texture and then drawn
+// as a single quad until one of the batches reports a change inside it (a box
+// breaking, an animated tile changing frame).
+// Textures are only held by the chunks on screen: a chunk that scrolls out
+// gives its texture back to a pool and is redrawn when it comes back.
+// If a RenderTexture can't be created the layers are drawn directly.
+class LayerCompositor {
+public:
+    static constexpr float CHUNK_SIZE = 8.f * TileGrid::CELL_SIZE;
+
+    // Bottom layer first; the batches must outlive the compositor
+    explicit LayerCompositor(std::vector<StaticBatch*> layers);
+
+    // Picks up the layers' changes (call after syncing them)
+    void update();
+    // Composites the chunks intersecting `area`
+    void draw(DrawList& target, const sf::FloatRect& area, RenderStats& stats);
+
+private:
+    static constexpr int NO_CACHE = -1;
+
+    struct Chunk {
+        int cache = NO_CACHE;    // index in m_caches
+        bool occupied = false;   // any quad of any layer touches it
+        bool dirty = true;
+    };
+
+    // Level load: drops every cached chunk and lays the grid over the layers
+    void regrid();
+    void extend(const sf::FloatRect& rect);
+    // Marks the chunks under `rect`; false if it sticks out of the grid
+    bool markDirty(const sf::FloatRect& rect);
+    sf::FloatRect chunkRect(int column, int row) const;
+    int acquireCache();
+    void redraw(Chunk& chunk, int column, int row, RenderStats& stats);
+
+    std::vector<StaticBatch*> m_layers;
+    std::vector<Chunk> m_chunks;             // row-major
+    int m_columns = 0;
+    int m_rows = 0;
+    sf::Vector2f m_origin;                   // top-left of chunk (0, 0), on a tile edge
+    std::vector<std::unique_ptr<sf::RenderTexture>> m_caches;
+    std::vector<int> m_freeCaches;
+    std::vector<sf::FloatRect> m_rects;      // scratch for changes / coverage
+    bool m_direct = false;                   // no RenderTexture: draw the layers as they are
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <optional>
+#include <string>
+
+// Time of day of a level, from its file name ("..._sunset", "..._night")
+enum class TimeOfDay {
+    Day,
+    Sunset,
+    Night
+};
+
+// Colour grading of a level, resolved once when the level is loaded so the
+// renderer never looks at level or animation names while drawing.
+// A new lighting variant is a TimeOfDay value plus a row in forLevel().
+struct LightingProfile {
+    TimeOfDay timeOfDay = TimeOfDay::Day;
+
+    // Per layer colours; nullopt keeps the sprite's own colour
+    std::optional<sf::Color> enemy;        // every enemy but the Emperor
+    std::optional<sf::Color> decoration;
+    sf::Color tile      = sf::Color::White;
+    sf::Color unlitTile = sf::Color::White; // tiles flagged CLighting::unlit
+
+    static LightingProfile forLevel(const std::string& levelPath) {
+        LightingProfile profile;
+        if (levelPath.find("night") != std::string::npos)
+            profile.timeOfDay = TimeOfDay::Night;
+        else if (levelPath.find("sunset") != std::string::npos)
+            profile.timeOfDay = TimeOfDay::Sunset;
+
+        // Tint levels, lightest first
+        sf::Color level1 = sf::Color::White;
+        sf::Color level2 = sf::Color::White;
+        sf::Color level3 = sf::Color::White;
+        switch (profile.timeOfDay) {
+            case TimeOfDay::Night:
+                level1 = sf::Color(150, 150, 150, 255);
+                level2 = sf::Color(100, 100, 100, 255);
+                level3 = sf::Color(70, 70, 70, 255);
+                break;
+            case TimeOfDay::Sunset:
+                level1 = sf::Color(255, 235, 200, 255);  // Soft warm light
+                level2 = sf::Color(255, 210, 170, 255);  // Light orange glow
+                level3 = sf::Color(245, 180, 140, 255);  // Mild dusk tone
+                break;
+            case TimeOfDay::Day:
+                break;
+        }
+
+        // Ancient Rome also tints enemies and decorations, and its tiles one level darker
+        if (levelPath.find("ancient") != std::string::npos) {
+            profile.enemy      = level1;
+            profile.decoration = level2;
+            profile.tile       = level3;
+        } else {
+            profile.tile       = level2;
+        }
+        return profile;
+    }
+};
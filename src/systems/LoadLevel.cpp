@@ -58,7 +58,7 @@ void LoadLevel::load(const std::string& levelPath, EntityManager& entityManager)
                 realX += LoadLevel::GRID_SIZE * LoadLevel::BLACKHOLE_OFFSET_MULTIPLIER;
                 realY += LoadLevel::GRID_SIZE * LoadLevel::BLACKHOLE_OFFSET_MULTIPLIER;
             }
-            auto tile = entityManager.addEntity("tile");
+            auto tile = entityManager.addEntity(TagId::Tile);
             tile->add<CUniqueID>(tileID);
             std::string fullAssetName =  m_game.worldType + assetType;
             // std::cout << "[DEBUG] Loaded Tile: " << assetType
@@ -68,6 +68,10 @@ void LoadLevel::load(const std::string& levelPath, EntityManager& entityManager)
             {
                 const Animation& anim = m_game.assets().getAnimation(fullAssetName);
                 tile->add<CAnimation>(anim, true);
+                // Treasure and armor stay bright at sunset/night
+                bool unlit = fullAssetName.find("FutureArmor") != std::string::npos ||
+                             fullAssetName.find("Treasure") != std::string::npos;
+                tile->add<CLighting>(unlit);
                 if (assetType == "LevelDoor" || assetType == "LevelDoorGold")
                 {
                     realY += LoadLevel::GRID_SIZE * LoadLevel::LEVELDOOR_REALY_OFFSET_MULTIPLIER;
@@ -110,7 +114,7 @@ void LoadLevel::load(const std::string& levelPath, EntityManager& entityManager)
             float realX = x * LoadLevel::GRID_SIZE + LoadLevel::HALF_GRID;
             float realY = m_game.getReferenceResolution().y - (y * LoadLevel::GRID_SIZE) - LoadLevel::HALF_GRID;
 
-            auto decor = entityManager.addEntity("decoration");
+            auto decor = entityManager.addEntity(TagId::Decoration);
             decor->add<CUniqueID>(decID);
             if (assetType == "GoldPipeTall" || "PipeTall")
                 realY += LoadLevel::GRID_SIZE * LoadLevel::PIPETALL_REALY_OFFSET_MULTIPLIER;
@@ -149,7 +153,7 @@ void LoadLevel::load(const std::string& levelPath, EntityManager& entityManager)
             float realX = x * LoadLevel::GRID_SIZE + LoadLevel::HALF_GRID;
             float realY = m_game.getReferenceResolution().y - (y * LoadLevel::GRID_SIZE) - LoadLevel::HALF_GRID;
             
-            auto player = entityManager.addEntity("player");
+            auto player = entityManager.addEntity(TagId::Player);
             if (m_game.assets().hasAnimation("PlayerStand"))
             {
                 const Animation& anim = m_game.assets().getAnimation("PlayerStand");
@@ -238,7 +242,7 @@ void LoadLevel::load(const std::string& levelPath, EntityManager& entityManager)
             }
             enemyIndex++;
             std::string enemyID = enemyTypeStr + "_" + std::to_string(enemyIndex);
-            auto enemy = entityManager.addEntity("enemy");
+            auto enemy = entityManager.addEntity(TagId::Enemy);
             enemy->add<CUniqueID>(enemyID);
             
             // Convert the enemyTypeStr to the proper EnemyType enum
@@ -275,6 +279,7 @@ void LoadLevel::load(const std::string& levelPath, EntityManager& entityManager)
             // Now add the components based on the properly set enemyType
             enemy->add<CEnemyAI>();
             enemy->add<CHealth>();
+            enemy->add<CState>();
             
             if (enemyType == EnemyType::Fast) {
                 enemy->get<CEnemyAI>().enemyType = EnemyType::Fast;
@@ -14,7 +14,7 @@ MovementSystem::MovementSystem(GameEngine& game,
 }
 void MovementSystem::updateCamera()
 {
-    auto players = m_entityManager.getEntities("player");
+    auto players = m_entityManager.getEntities(TagId::Player);
     if (players.empty()) {
         return;
     }
@@ -60,7 +60,7 @@ void MovementSystem::updateCamera()
     float targetZoomStrength = ZOOM_STRENGTH; // Default zoom level
 
     // Find Emperor boss and check health
-    for (auto& enemy : m_entityManager.getEntities("enemy")) {
+    for (auto& enemy : m_entityManager.getEntities(TagId::Enemy)) {
         if (enemy->has<CEnemyAI>() && enemy->has<CHealth>()) {
             auto& enemyAI = enemy->get<CEnemyAI>();
             auto& health = enemy->get<CHealth>();
@@ -109,15 +109,15 @@ void MovementSystem::updateCamera()
         // std::cout << "View size after zoom: " << size.x << " x " << size.y << "\n";
     }
 
-    // Apply the final camera
-    m_game.window().setView(m_cameraView);
+    // The camera is applied to the window by PlayRenderer::render(); update()
+    // may run on the simulation side of the render thread, away from the window
 }
 
 
 void MovementSystem::update(float deltaTime)
 {
     // -- Player movement, etc. --
-    for (auto& entity : m_entityManager.getEntities("player")) {
+    for (auto& entity : m_entityManager.getEntities(TagId::Player)) {
         auto& transform = entity->get<CTransform>();
         auto& state     = entity->get<CState>();
         auto& canim     = entity->get<CAnimation>();
@@ -177,7 +177,7 @@ void MovementSystem::update(float deltaTime)
     updateCamera();
 
     // Sword follows player
-    auto players = m_entityManager.getEntities("player");
+    auto players = m_entityManager.getEntities(TagId::Player);
     if (!players.empty()) {
         auto& player = players[0];
         auto& pTrans = player->get<CTransform>();
@@ -186,7 +186,7 @@ void MovementSystem::update(float deltaTime)
         float offsetX = (dir < 0) ? SWORD_OFFSET_X_LEFT : SWORD_OFFSET_X_RIGHT;
         float offsetY = SWORD_OFFSET_Y;
 
-        for (auto& sword : m_entityManager.getEntities("sword")) {
+        for (auto& sword : m_entityManager.getEntities(TagId::Sword)) {
             if (!sword->has<CTransform>()) continue;
             auto& swTrans = sword->get<CTransform>();
             swTrans.pos.x = pTrans.pos.x + offsetX;
@@ -203,75 +203,38 @@ void MovementSystem::update(float deltaTime)
         }
     }
 
-    auto enemySwords = m_entityManager.getEntities("EmperorSword");
-    for (auto& eSword : enemySwords) {
-        if (!eSword->has<CTransform>()) continue;
-        auto& swTrans = eSword->get<CTransform>();
-    
-        // Only swords with active stop timers (timer > 0) should count down
-        if (eSword->has<CStopAfterTime>()) {
-            auto& stopTimer = eSword->get<CStopAfterTime>();
-    
-            if (stopTimer.timer > 0.f) {
-                stopTimer.timer -= deltaTime;
-                if (stopTimer.timer <= 0.f) {
-                    swTrans.velocity = Vec2(0.f, 0.f);
-                    stopTimer.timer = 0.f; // Mark as "stopped"
+    // Projectiles: one pass down the CTransform pool instead of five tag groups
+    m_entityManager.each<CTransform>([&](Entity& entity, CTransform& trans) {
+        switch (entity.tag()) {
+            case TagId::EmperorSword:
+            case TagId::EmperorBlackHole:
+                // Only those with active stop timers (timer > 0) should count down
+                if (entity.has<CStopAfterTime>()) {
+                    auto& stopTimer = entity.get<CStopAfterTime>();
+                    if (stopTimer.timer > 0.f) {
+                        stopTimer.timer -= deltaTime;
+                        if (stopTimer.timer <= 0.f) {
+                            trans.velocity = Vec2(0.f, 0.f);
+                            stopTimer.timer = 0.f; // Mark as "stopped"
+                        }
+                    }
                 }
-            }
-        }
-    
-        swTrans.pos += swTrans.velocity * deltaTime;
-
-    }
-
-    for (auto& blackHole : m_entityManager.getEntities("emperorBlackHole")) {
-        if (!blackHole->has<CTransform>()) continue;
-        auto& swTrans = blackHole->get<CTransform>();
-    
-        // Only swords with active stop timers (timer > 0) should count down
-        if (blackHole->has<CStopAfterTime>()) {
-            auto& stopTimer = blackHole->get<CStopAfterTime>();
-    
-            if (stopTimer.timer > 0.f) {
-                stopTimer.timer -= deltaTime;
-                if (stopTimer.timer <= 0.f) {
-                    swTrans.velocity = Vec2(0.f, 0.f);
-                    stopTimer.timer = 0.f; // Mark as "stopped"
+                break;
+            case TagId::EmperorSwordArmor:
+                if (entity.has<CStopAfterTime>()) {
+                    auto& stopTimer = entity.get<CStopAfterTime>();
+                    stopTimer.timer -= deltaTime;
+                    if (stopTimer.timer <= 0.f) {
+                        trans.velocity = Vec2<float>(0.f, 0.f);
+                    }
                 }
-            }
-        }
-    
-        swTrans.pos += swTrans.velocity * deltaTime;
-
-    }
-    
-    auto armorSwords = m_entityManager.getEntities("EmperorSwordArmor");
-    for (auto& sword : armorSwords) {
-        auto& trans = sword->get<CTransform>();
-
-        if (sword->has<CStopAfterTime>()) {
-            auto& stopTimer = sword->get<CStopAfterTime>();
-            stopTimer.timer -= deltaTime;
-
-            if (stopTimer.timer <= 0.f) {
-                trans.velocity = Vec2<float>(0.f, 0.f);
-            }
+                break;
+            case TagId::EnemyBullet:
+            case TagId::PlayerBullet:
+                break;
+            default:
+                return;
         }
         trans.pos += trans.velocity * deltaTime;
-    }
-
-    for (auto& bullet : m_entityManager.getEntities("enemyBullet")) {
-        if (!bullet->has<CTransform>()) continue;
-        auto& trans = bullet->get<CTransform>();
-        trans.pos += trans.velocity * deltaTime;
-    }
-
-    for (auto& bullet : m_entityManager.getEntities("playerBullet")) {
-        if (!bullet->has<CTransform>()) continue;
-        auto& trans = bullet->get<CTransform>();
-        trans.pos += trans.velocity * deltaTime;
-    }
-
-    m_game.window().setView(m_cameraView);
+    });
 }
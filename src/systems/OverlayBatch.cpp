@@ -0,0 +1,76 @@
+#include "OverlayBatch.h"
+
+bool CachedText::set(const sf::Font& font, unsigned int characterSize, const std::string& utf8) {
+    if (m_font == &font && m_characterSize == characterSize && m_string == utf8) return false;
+
+    m_text.setFont(font);
+    m_text.setCharacterSize(characterSize);
+    m_text.setString(sf::String::fromUtf8(utf8.begin(), utf8.end()));
+    m_font = &font;
+    m_characterSize = characterSize;
+    m_string = utf8;
+    m_bounds = m_text.getLocalBounds();   // lays the glyphs out once, here
+    m_laidOut = true;
+    return true;
+}
+
+bool CachedText::consumeLayout() {
+    bool laidOut = m_laidOut;
+    m_laidOut = false;
+    return laidOut;
+}
+
+void OverlayBatch::rect(const sf::FloatRect& rect, sf::Color color) {
+    if (rect.width <= 0.f || rect.height <= 0.f) return;
+
+    sf::Vector2f topLeft(rect.left, rect.top);
+    sf::Vector2f topRight(rect.left + rect.width, rect.top);
+    sf::Vector2f bottomLeft(rect.left, rect.top + rect.height);
+    sf::Vector2f bottomRight(rect.left + rect.width, rect.top + rect.height);
+
+    m_quads.emplace_back(topLeft,     color);
+    m_quads.emplace_back(topRight,    color);
+    m_quads.emplace_back(bottomLeft,  color);
+    m_quads.emplace_back(bottomLeft,  color);
+    m_quads.emplace_back(topRight,    color);
+    m_quads.emplace_back(bottomRight, color);
+    ++m_stats.quads;
+}
+
+void OverlayBatch::outline(const sf::FloatRect& r, sf::Color color, float thickness) {
+    float t = thickness;
+    rect({r.left - t,       r.top - t,        r.width + 2.f * t, t},        color);   // top
+    rect({r.left - t,       r.top + r.height, r.width + 2.f * t, t},        color);   // bottom
+    rect({r.left - t,       r.top,            t,                 r.height}, color);   // left
+    rect({r.left + r.width, r.top,            t,                 r.height}, color);   // right
+}
+
+void OverlayBatch::line(sf::Vector2f from, sf::Vector2f to, sf::Color color) {
+    m_lines.emplace_back(from, color);
+    m_lines.emplace_back(to, color);
+}
+
+void OverlayBatch::text(CachedText& text, sf::Vector2f position) {
+    if (text.consumeLayout()) ++m_stats.textLayouts;
+    m_texts.emplace_back(&text, position);
+}
+
+void OverlayBatch::flush(DrawList& target) {
+    if (!m_quads.empty()) {
+        target.draw(m_quads.data(), m_quads.size(), sf::Triangles);
+        ++m_stats.drawCalls;
+    }
+    if (!m_lines.empty()) {
+        target.draw(m_lines.data(), m_lines.size(), sf::Lines);
+        ++m_stats.drawCalls;
+    }
+    for (auto& [text, position] : m_texts) {
+        text->m_text.setPosition(position);
+        target.draw(text->m_text);
+        ++m_stats.drawCalls;
+    }
+
+    m_quads.clear();
+    m_lines.clear();
+    m_texts.clear();
+}
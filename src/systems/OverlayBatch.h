@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "DrawList.h"
+#include <string>
+#include <vector>
+#include <utility>
+
+// Per-frame overlay counters (drawn with the bounding boxes, key B)
+struct OverlayStats {
+    size_t quads = 0;         // bar rects and outline edges
+    size_t drawCalls = 0;
+    size_t textLayouts = 0;   // texts whose glyphs were rebuilt this frame
+};
+
+// An sf::Text that keeps its glyph geometry until the font, size or string
+// actually changes. A temporary sf::Text per frame lays out every glyph again;
+// one of these per label only pays for that when the label changes.
+class CachedText {
+public:
+    // Strings are UTF-8. Returns true when the text was laid out again.
+    bool set(const sf::Font& font, unsigned int characterSize, const std::string& utf8);
+    void setFillColor(const sf::Color& color) { m_text.setFillColor(color); }
+
+    const sf::FloatRect& localBounds() const { return m_bounds; }
+    const sf::Text& text() const { return m_text; }
+
+    // True once after each new layout (OverlayBatch counts them)
+    bool consumeLayout();
+
+private:
+    friend class OverlayBatch;
+
+    sf::Text m_text;
+    std::string m_string;
+    const sf::Font* m_font = nullptr;
+    unsigned int m_characterSize = 0;
+    sf::FloatRect m_bounds;
+    bool m_laidOut = false;
+};
+
+// HUD and health-bar geometry: untextured rects go into one triangle list,
+// divider lines into one line list, and the texts are drawn on top. flush()
+// draws quads, then lines, then texts, each in submission order, so what used
+// to be a handful of RectangleShape draws per enemy is now two calls in total.
+class OverlayBatch {
+public:
+    void rect(const sf::FloatRect& rect, sf::Color color);
+    // Border drawn outside `rect`, like an sf::Shape outline
+    void outline(const sf::FloatRect& rect, sf::Color color, float thickness);
+    void line(sf::Vector2f from, sf::Vector2f to, sf::Color color);
+    // The same text can be queued at several positions; it must outlive flush()
+    void text(CachedText& text, sf::Vector2f position);
+
+    void flush(DrawList& target);
+
+    const OverlayStats& stats() const { return m_stats; }
+    void resetStats() { m_stats = OverlayStats(); }
+
+private:
+    std::vector<sf::Vertex> m_quads;   // sf::Triangles, 6 per rect
+    std::vector<sf::Vertex> m_lines;   // sf::Lines
+    std::vector<std::pair<CachedText*, sf::Vector2f>> m_texts;
+    OverlayStats m_stats;
+};
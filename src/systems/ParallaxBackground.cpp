@@ -0,0 +1,176 @@
+#include "ParallaxBackground.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+
+void ParallaxBackground::addLayer(const std::string& path, float scrollFactor) {
+    Layer layer;
+    layer.path = path;
+    layer.scrollFactor = scrollFactor;
+    layer.size = readImageSize(path);
+    layer.decoding = std::async(std::launch::async, [path]() {
+        auto image = std::make_unique<sf::Image>();
+        if (!image->loadFromFile(path)) {
+            std::cerr << "[ERROR] Could not load background image: " << path << std::endl;
+            image.reset();
+        }
+        return image;
+    });
+    m_layers.push_back(std::move(layer));
+}
+
+void ParallaxBackground::clear() {
+    m_layers.clear();   // waits for any decode still running
+}
+
+// Width and height from the IHDR chunk, so the camera can be placed before
+// the image is decoded. Zero for anything that isn't a PNG.
+sf::Vector2u ParallaxBackground::readImageSize(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    unsigned char header[24];
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header))) return {};
+
+    static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (!std::equal(signature, signature + 8, header)) return {};
+
+    auto bigEndian = [&](int at) {
+        return (static_cast<uint32_t>(header[at]) << 24) | (static_cast<uint32_t>(header[at + 1]) << 16) |
+               (static_cast<uint32_t>(header[at + 2]) << 8) | static_cast<uint32_t>(header[at + 3]);
+    };
+    return {bigEndian(16), bigEndian(20)};
+}
+
+void ParallaxBackground::finishDecoding(Layer& layer) {
+    layer.image = layer.decoding.get();
+    if (!layer.image) return;
+
+    layer.size = layer.image->getSize();
+    if (layer.size.x == 0 || layer.size.y == 0) {
+        layer.image.reset();
+        return;
+    }
+
+    layer.columns = (layer.size.x + TILE_SIZE - 1) / TILE_SIZE;
+    layer.rows    = (layer.size.y + TILE_SIZE - 1) / TILE_SIZE;
+    layer.tiles.resize(static_cast<size_t>(layer.columns) * layer.rows);
+    for (unsigned int row = 0; row < layer.rows; ++row) {
+        for (unsigned int column = 0; column < layer.columns; ++column) {
+            int left = static_cast<int>(column * TILE_SIZE);
+            int top  = static_cast<int>(row * TILE_SIZE);
+            layer.tiles[row * layer.columns + column].area = sf::IntRect(
+                left, top,
+                std::min(static_cast<int>(TILE_SIZE), static_cast<int>(layer.size.x) - left),
+                std::min(static_cast<int>(TILE_SIZE), static_cast<int>(layer.size.y) - top));
+        }
+    }
+}
+
+ParallaxBackground::Placement ParallaxBackground::placementOf(const Layer& layer, sf::Vector2f screen,
+                                                              const sf::View& camera) {
+    Placement place;
+    if (layer.scrollFactor <= 0.f) {
+        place.scale = sf::Vector2f(screen.x / layer.size.x, screen.y / layer.size.y);
+        return place;
+    }
+
+    float scale = screen.y / layer.size.y;
+    place.scale = sf::Vector2f(scale, scale);
+    place.repeatWidth = layer.size.x * scale;
+    float scroll = std::fmod(camera.getCenter().x * layer.scrollFactor, place.repeatWidth);
+    if (scroll < 0.f) scroll += place.repeatWidth;
+    place.firstX = -scroll - place.repeatWidth;   // one repeat left of the screen for the prefetch margin
+    return place;
+}
+
+void ParallaxBackground::draw(DrawList& target, const sf::View& camera) {
+    const sf::Vector2f screen(static_cast<float>(target.getSize().x), static_cast<float>(target.getSize().y));
+    int uploads = 0;
+
+    for (Layer& layer : m_layers) {
+        if (layer.decoding.valid() &&
+            layer.decoding.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            finishDecoding(layer);
+        }
+        if (layer.tiles.empty()) continue;   // still decoding (or failed)
+
+        const Placement place = placementOf(layer, screen, camera);
+        const float margin = PREFETCH_TILES * TILE_SIZE * place.scale.x;
+
+        // Calls fn(originX) for every repeat of the layer up to `right`
+        auto forEachRepeat = [&](float right, auto&& fn) {
+            for (float originX = place.firstX; originX <= right; originX += place.repeatWidth) {
+                fn(originX);
+                if (place.repeatWidth <= 0.f) break;
+            }
+        };
+
+        // Columns on screen or within the margin, over all repeats
+        m_wanted.assign(layer.columns, false);
+        forEachRepeat(screen.x + margin, [&](float originX) {
+            for (unsigned int column = 0; column < layer.columns; ++column) {
+                const sf::IntRect& area = layer.tiles[column].area;
+                float left  = originX + area.left * place.scale.x;
+                float right = left + area.width * place.scale.x;
+                if (right >= -margin && left <= screen.x + margin) m_wanted[column] = true;
+            }
+        });
+
+        // Upload what's wanted (a few per frame), free the rest
+        for (unsigned int row = 0; layer.image && row < layer.rows; ++row) {
+            for (unsigned int column = 0; column < layer.columns; ++column) {
+                Tile& tile = layer.tiles[row * layer.columns + column];
+                if (!m_wanted[column]) {
+                    tile.texture.reset();
+                    continue;
+                }
+                if (tile.texture || uploads >= UPLOADS_PER_FRAME) continue;
+                auto texture = std::make_unique<sf::Texture>();
+                if (texture->loadFromImage(*layer.image, tile.area)) {
+                    tile.texture = std::move(texture);
+                }
+                ++uploads;
+            }
+        }
+
+        // A fixed layer always wants every tile, so none will ever need the
+        // image again once they are all up
+        if (layer.image && layer.scrollFactor <= 0.f &&
+            std::all_of(layer.tiles.begin(), layer.tiles.end(),
+                        [](const Tile& tile) { return tile.texture != nullptr; })) {
+            layer.image.reset();
+        }
+
+        forEachRepeat(screen.x, [&](float originX) {
+            for (const Tile& tile : layer.tiles) {
+                if (!tile.texture) continue;
+                float left = originX + tile.area.left * place.scale.x;
+                if (left > screen.x || left + tile.area.width * place.scale.x < 0.f) continue;
+                sf::Sprite sprite(*tile.texture);
+                sprite.setScale(place.scale);
+                sprite.setPosition(left, tile.area.top * place.scale.y);
+                target.draw(sprite);
+            }
+        });
+    }
+}
+
+size_t ParallaxBackground::residentTiles() const {
+    size_t resident = 0;
+    for (const Layer& layer : m_layers) {
+        for (const Tile& tile : layer.tiles) {
+            if (tile.texture) ++resident;
+        }
+    }
+    return resident;
+}
+
+size_t ParallaxBackground::totalTiles() const {
+    size_t total = 0;
+    for (const Layer& layer : m_layers) {
+        total += layer.tiles.size();
+    }
+    return total;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "DrawList.h"
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Level background made of layers, drawn back to front in window space.
+// A layer's image is decoded on a worker thread as soon as it is added. Once
+// decoded it is cut into TILE_SIZE squares that are uploaded a few per frame,
+// only while they are on screen (or about to be), and freed again when they
+// scroll far away. Entering a level never waits on PNG decoding or on one big
+// texture upload, and VRAM holds about a screenful of tiles per layer.
+// A fixed layer never evicts, so its decoded image is dropped from RAM as
+// soon as its last tile is uploaded.
+//
+// scrollFactor 0 is the classic background: fixed to the window and stretched
+// over it. A factor > 0 scales the layer to the window height, repeats it
+// horizontally and scrolls it by factor * the camera's x.
+class ParallaxBackground {
+public:
+    static constexpr unsigned int TILE_SIZE = 512;
+    static constexpr int UPLOADS_PER_FRAME = 2;
+    static constexpr int PREFETCH_TILES = 1;   // tile columns kept on each side of the screen
+
+    void addLayer(const std::string& path, float scrollFactor);
+    void clear();
+
+    // Pixel size of a PNG from its header (no decoding, no texture: works headless)
+    static sf::Vector2u readImageSize(const std::string& path);
+
+    // Streams tiles in/out for `camera` and draws every layer.
+    // The target's current view must be its default (window) view.
+    void draw(DrawList& target, const sf::View& camera);
+
+    size_t residentTiles() const;
+    size_t totalTiles() const;
+
+private:
+    struct Tile {
+        sf::IntRect area;                    // in the layer's image
+        std::unique_ptr<sf::Texture> texture;
+    };
+
+    struct Layer {
+        std::string path;
+        float scrollFactor = 0.f;
+        sf::Vector2u size;
+        std::future<std::unique_ptr<sf::Image>> decoding;
+        std::unique_ptr<sf::Image> image;    // kept so evicted tiles can come back (fixed layers: until all are up)
+        std::vector<Tile> tiles;             // row-major
+        unsigned int columns = 0;
+        unsigned int rows = 0;
+    };
+
+    // Where a layer goes on screen this frame
+    struct Placement {
+        sf::Vector2f scale;
+        float firstX = 0.f;                  // x of the leftmost repeat
+        float repeatWidth = 0.f;             // 0: drawn once
+    };
+
+    static void finishDecoding(Layer& layer);
+    static Placement placementOf(const Layer& layer, sf::Vector2f screen, const sf::View& camera);
+
+    std::vector<Layer> m_layers;
+    std::vector<bool> m_wanted;              // scratch: tile columns to keep resident
+};
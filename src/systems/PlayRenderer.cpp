@@ -3,27 +3,79 @@
 #include "DialogueSystem.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
 #include "SpriteUtils.h"
 
 PlayRenderer::PlayRenderer(GameEngine& game,
                        EntityManager& entityManager,
-                       sf::Sprite& backgroundSprite,
-                       sf::Texture& backgroundTexture,
+                       ParallaxBackground& background,
                        sf::View& cameraView,
-                       int& score)
+                       int& score,
+                       const TileGrid& tileGrid)
     : m_game(game),
       m_entityManager(entityManager),
-      m_backgroundSprite(backgroundSprite),
-      m_backgroundTexture(backgroundTexture),
+      m_background(background),
       m_cameraView(cameraView),
+      m_tileGrid(tileGrid),
       m_showGrid(false),
       m_showBoundingBoxes(false),
       m_score(score),
       m_timeofday("day"),
+      m_staticLayers({&m_decorationBatch, &m_tileBatch}),
       m_dialogueSystem(nullptr)
 {
 }
 
+sf::Vector2f PlayRenderer::interpolate(sf::Vector2f from, sf::Vector2f to, float alpha) {
+    sf::Vector2f delta = to - from;
+    if (delta.x * delta.x + delta.y * delta.y > SNAP_DISTANCE * SNAP_DISTANCE) return to;
+    return from + delta * alpha;
+}
+
+Vec2<float> PlayRenderer::drawPos(const CTransform& transform) const {
+    sf::Vector2f pos = interpolate(transform.prevPos, transform.pos, m_interpolation);
+    return Vec2<float>(pos.x, pos.y);
+}
+
+bool PlayRenderer::spriteBounds(Entity* entity, sf::FloatRect& rect) const {
+    if (!entity->has<CTransform>() || !entity->has<CAnimation>()) return false;
+    const Vec2<float> pos = drawPos(entity->get<CTransform>());
+    sf::Vector2i size = entity->get<CAnimation>().animation.getSize();
+    rect = sf::FloatRect(pos.x - size.x / 2.f, pos.y - size.y / 2.f,
+                         static_cast<float>(size.x), static_cast<float>(size.y));
+    return true;
+}
+
+// Queue an animation's current frame centred on `pos`, the way the sprite
+// copies used to be drawn: the animation sprite's rotation and scale are kept
+// unless `scale` overrides it
+void PlayRenderer::batchAnimation(const Animation& animation, const Vec2<float>& pos, int layer,
+                                  std::optional<sf::Vector2f> scale) {
+    const sf::Sprite& sprite = animation.getSprite();
+    sf::Transform transform;
+    transform.translate(pos.x, pos.y)
+             .rotate(sprite.getRotation())
+             .scale(scale ? *scale : sprite.getScale())
+             .translate(-animation.getSize().x / 2.f, -animation.getSize().y / 2.f);
+    m_spriteBatch.submit(sprite.getTexture(), sprite.getTextureRect(), transform, sprite.getColor(), layer);
+}
+
+// Culling test for the moving layers; counts towards the overlay stats
+bool PlayRenderer::visible(Entity* entity) {
+    sf::FloatRect rect;
+    bool onScreen = true;
+    if (spriteBounds(entity, rect)) {
+        onScreen = rect.intersects(m_cullRect);
+    } else if (entity->has<CTransform>()) {
+        const Vec2<float> pos = drawPos(entity->get<CTransform>());
+        onScreen = m_cullRect.contains(pos.x, pos.y);
+    }
+    ++(onScreen ? m_renderStats.drawn : m_renderStats.culled);
+    return onScreen;
+}
+
 void PlayRenderer::setShowGrid(bool show) {
     m_showGrid = show;
 }
@@ -46,12 +98,12 @@ void PlayRenderer::renderDialogue(DialogueSystem* dialogueSystem)
         return;
     }
 
-    sf::View currentView = m_game.window().getView();
-    m_game.window().setView(m_game.window().getDefaultView());
+    sf::View currentView = m_game.frame().getView();
+    m_game.frame().setView(m_game.frame().getDefaultView());
 
     const DialogueMessage* message = dialogueSystem->getCurrentMessage();
     if (!message) {
-        m_game.window().setView(currentView);
+        m_game.frame().setView(currentView);
         return;
     }
 
@@ -80,11 +132,6 @@ void PlayRenderer::renderDialogue(DialogueSystem* dialogueSystem)
                                 m_game.assets().getFont("Japanese") : 
                                 m_game.assets().getFont("Menu");
     
-    // Set the speaker text font
-    dialogueSystem->speakerText.setFont(fontToUse);
-    dialogueSystem->speakerText.setCharacterSize(30);
-    dialogueSystem->speakerText.setFillColor(message->speakerColor);
-    
     std::string speakerWithUniverse;
     if (m_game.getLanguage() == "English") {
         if (message->speaker.find("Alien Legionary") != std::string::npos) {
@@ -107,39 +154,18 @@ void PlayRenderer::renderDialogue(DialogueSystem* dialogueSystem)
             speakerWithUniverse = message->speaker + " [宇宙 #" + std::to_string(m_game.alternateUniverseNumber2) + "]";
         }
     }
-    dialogueSystem->speakerText.setString(
-        sf::String::fromUtf8(
-            speakerWithUniverse.begin(), 
-            speakerWithUniverse.end()
-        )
-    );
-    dialogueSystem->speakerText.setPosition(textX, boxY + 15.f);
-
-    // Set the message text font
-    dialogueSystem->messageText.setFont(fontToUse);
-    dialogueSystem->messageText.setCharacterSize(message->messageFontSize); 
-    dialogueSystem->messageText.setFillColor(message->messageColor);
-    auto displayed = dialogueSystem->getDisplayedText();
-    dialogueSystem->messageText.setString(
-        sf::String::fromUtf8(
-            displayed.begin(), 
-            displayed.end()
-        )
-    );
-    dialogueSystem->messageText.setPosition(textX, boxY + 50.f);
-
-    m_game.window().draw(dialogueSystem->dialogueBox);
-    m_game.window().draw(dialogueSystem->portraitSprite);
-    m_game.window().draw(dialogueSystem->speakerText);
-    m_game.window().draw(dialogueSystem->messageText);
+    // The texts are only laid out again when the typewriter adds a character
+    // or the message changes
+    m_dialogueSpeakerText.set(fontToUse, 30, speakerWithUniverse);
+    m_dialogueSpeakerText.setFillColor(message->speakerColor);
+    m_overlay.text(m_dialogueSpeakerText, {textX, boxY + 15.f});
+
+    m_dialogueMessageText.set(fontToUse, message->messageFontSize, dialogueSystem->getDisplayedText());
+    m_dialogueMessageText.setFillColor(message->messageColor);
+    m_overlay.text(m_dialogueMessageText, {textX, boxY + 50.f});
 
     if (!dialogueSystem->isTyping()) 
     {
-        // Set up font once
-        dialogueSystem->continueText.setFont(fontToUse);
-        dialogueSystem->continueText.setCharacterSize(16);
-        dialogueSystem->continueText.setFillColor(sf::Color::White);
-    
         // Calculate remaining time if we are waiting
         int remainingTime = static_cast<int>(5.0f - dialogueSystem->getCompletionTimer());
     
@@ -156,187 +182,150 @@ void PlayRenderer::renderDialogue(DialogueSystem* dialogueSystem)
             ? (m_game.getLanguage() == "Japanese" ? japWaiting : engWaiting)
             : (m_game.getLanguage() == "Japanese" ? japPrompt  : engPrompt);
     
-        // Convert from UTF-8 so SFML renders correctly
-        dialogueSystem->continueText.setString(
-            sf::String::fromUtf8(chosenText.begin(), chosenText.end())
-        );
+        m_dialogueContinueText.set(fontToUse, 16, chosenText);
+        m_dialogueContinueText.setFillColor(sf::Color::White);
     
-        float continueTextHeight = dialogueSystem->continueText.getLocalBounds().height;
+        float continueTextHeight = m_dialogueContinueText.localBounds().height;
         float continueTextOffsetX = (message->speaker == "エイリアン兵士" || message->speaker == "***ガイド***" || message->speaker == "Alien Legionary" || message->speaker == "***GUIDE***") ? 150.f : 10.f;
 
-        dialogueSystem->continueText.setPosition(
+        m_overlay.text(m_dialogueContinueText, {
             boxX + continueTextOffsetX,
             boxY + boxHeight - continueTextHeight - 10.f
-        );
-        m_game.window().draw(dialogueSystem->continueText);
+        });
     }
 
-    m_game.window().setView(currentView);
+    m_game.frame().draw(dialogueSystem->dialogueBox);
+    m_game.frame().draw(dialogueSystem->portraitSprite);
+    m_overlay.flush(m_game.frame());
+
+    m_game.frame().setView(currentView);
 }
 
 void PlayRenderer::render() {
-    m_game.window().clear();
+    m_game.frame().clear();
 
-    // Draw background (scaled to window)
-    sf::Vector2u windowSize = m_game.window().getSize();
-    sf::Vector2u textureSize = m_backgroundTexture.getSize();
-    float scaleX = static_cast<float>(windowSize.x) / static_cast<float>(textureSize.x);
-    float scaleY = static_cast<float>(windowSize.y) / static_cast<float>(textureSize.y);
-    m_backgroundSprite.setScale(scaleX, scaleY);
-
-    sf::View defaultView = m_game.window().getDefaultView();
-    m_game.window().setView(defaultView);
-    m_game.window().draw(m_backgroundSprite);
+    // Draw background layers in window space (tiles stream in as they come on screen)
+    sf::Vector2u windowSize = m_game.frame().getSize();
+    sf::View defaultView = m_game.frame().getDefaultView();
+    m_game.frame().setView(defaultView);
+    {
+        TRACE_ZONE("background");
+        m_background.draw(m_game.frame(), m_cameraView);
+    }
 
-    m_game.window().setView(m_cameraView);
+    m_game.frame().setView(m_cameraView);
     sf::RectangleShape debugBox;
 
+    // Only what intersects the camera (plus margin) gets drawn
+    const sf::Vector2f viewSize   = m_cameraView.getSize();
+    const sf::Vector2f viewCenter = m_cameraView.getCenter();
+    m_cullRect = sf::FloatRect(viewCenter.x - viewSize.x / 2.f - CULL_MARGIN,
+                               viewCenter.y - viewSize.y / 2.f - CULL_MARGIN,
+                               viewSize.x + 2.f * CULL_MARGIN,
+                               viewSize.y + 2.f * CULL_MARGIN);
+    m_renderStats = RenderStats();
+    m_spriteBatch.resetStats();
+    m_overlay.resetStats();
+
     if (m_showGrid) {
         drawGrid();
     }
 
-    sf::Color normalFilter(255, 255, 255, 255);
-
-    sf::Color darkFilterLevel1 = normalFilter;
-    sf::Color darkFilterLevel2 = normalFilter;
-    sf::Color darkFilterLevel3 = normalFilter;
-    
-    //if ((m_game.getCurrentLevel().find("night") != std::string::npos) && (m_game.getCurrentLevel().find("ancient") != std::string::npos)){
-    if (m_game.getCurrentLevel().find("night") != std::string::npos){
-        darkFilterLevel1 = sf::Color(150, 150, 150, 255);
-        darkFilterLevel2 = sf::Color(100, 100, 100, 255);
-        darkFilterLevel3 = sf::Color(70, 70, 70, 255);
-    //} else if ((m_game.getCurrentLevel().find("sunset") != std::string::npos) && (m_game.getCurrentLevel().find("ancient") != std::string::npos)) {
-    } else if (m_game.getCurrentLevel().find("sunset") != std::string::npos) {
-        darkFilterLevel1 = sf::Color(255, 235, 200, 255);  // Soft warm light
-        darkFilterLevel2 = sf::Color(255, 210, 170, 255);  // Light orange glow
-        darkFilterLevel3 = sf::Color(245, 180, 140, 255);  // Mild dusk tone
-    }
-
-
-    // Render decorations
-    for (auto& dec : m_entityManager.getEntities("decoration")) {
-        auto& transform = dec->get<CTransform>();
-        if (dec->has<CAnimation>()) {
-            auto& anim = dec->get<CAnimation>();
-            sf::Sprite sprite = anim.animation.getSprite();
-            sprite.setPosition(transform.pos.x, transform.pos.y);
-            sprite.setOrigin(anim.animation.getSize().x / 2.f,
-                             anim.animation.getSize().y / 2.f);
-            if (m_game.getCurrentLevel().find("ancient") != std::string::npos) {
-                sprite.setColor(darkFilterLevel2);
-            }
-            m_game.window().draw(sprite);
+    {
+        TRACE_ZONE("static layers");
+        // Decorations and tiles: vertex arrays per texture, tinted once at load.
+        // The colours come from the level's lighting profile and the tiles' CLighting flag.
+        auto decorations = m_entityManager.getEntities(TagId::Decoration);
+        auto tiles       = m_entityManager.getEntities(TagId::Tile);
+        if (!m_decorationBatch.built()) {
+            m_decorationBatch.build(decorations, [this](const Entity& decoration) {
+                return m_lighting.decoration.value_or(decoration.get<CAnimation>().animation.getSprite().getColor());
+            });
         }
-    }
+        if (!m_tileBatch.built()) {
+            m_tileBatch.build(tiles, [this](const Entity& tile) {
+                bool unlit = tile.has<CLighting>() && tile.get<CLighting>().unlit;
+                return unlit ? m_lighting.unlitTile : m_lighting.tile;
+            });
+        }
+        m_decorationBatch.sync(decorations);
+        m_tileBatch.sync(tiles);
 
-    // Render tiles
-    for (auto& tile : m_entityManager.getEntities("tile")) {
-        auto& transform = tile->get<CTransform>();
-    
-        if (tile->has<CAnimation>()) {
-            auto& animation = tile->get<CAnimation>();
-            sf::Sprite sprite = animation.animation.getSprite();
-            sprite.setPosition(transform.pos.x, transform.pos.y);
-            sprite.setOrigin(animation.animation.getSize().x / 2.f,
-                             animation.animation.getSize().y / 2.f);
-    
-            sf::Color appliedColor = normalFilter;
+        // Both layers come from cached chunk textures, redrawn only where they changed
+        m_staticLayers.update();
+        m_staticLayers.draw(m_game.frame(), m_cullRect, m_renderStats);
+    }
 
-            const std::string& levelName = m_game.getCurrentLevel();
-            const std::string& animName  = animation.animation.getName();
-            
-            if (animName.find("FutureArmor") != std::string::npos) {
-                appliedColor = normalFilter;
-            }
-            else if (animName.find("Treasure") != std::string::npos) {
-                appliedColor = normalFilter;
-            }
-            else if (levelName.find("ancient") != std::string::npos) {
-                appliedColor = darkFilterLevel3;
-            }
-            else {
-                appliedColor = darkFilterLevel2;
-            }
-            
-            sprite.setColor(appliedColor);
-            m_game.window().draw(sprite);
-        }
-        if (m_showBoundingBoxes && tile->has<CBoundingBox>()) {
+    if (m_showBoundingBoxes) {
+        m_tileGrid.query(m_cullRect, m_visibleEntities);
+        for (auto& tile : m_visibleEntities) {
+            auto& transform = tile->get<CTransform>();
             auto& bbox = tile->get<CBoundingBox>();
             debugBox.setSize(sf::Vector2f(bbox.size.x, bbox.size.y));
             debugBox.setOrigin(bbox.halfSize.x, bbox.halfSize.y);
-            debugBox.setPosition(transform.pos.x, transform.pos.y);
+            debugBox.setPosition(drawPos(transform).x, drawPos(transform).y);
             debugBox.setFillColor(sf::Color::Transparent);
             debugBox.setOutlineColor(sf::Color::Red);
             debugBox.setOutlineThickness(2.f);
-            m_game.window().draw(debugBox);
+            m_game.frame().draw(debugBox);
         }
     }
 
     // Render fragments
-    for (auto& fragment : m_entityManager.getEntities("fragment")) {
+    for (auto& fragment : m_entityManager.getEntities(TagId::Fragment)) {
+        if (!visible(fragment)) continue;
         auto& transform = fragment->get<CTransform>();
         if (fragment->has<CAnimation>()) {
             auto& anim = fragment->get<CAnimation>();
-            sf::Sprite sprite = anim.animation.getSprite();
-            sprite.setPosition(transform.pos.x, transform.pos.y);
-            sprite.setOrigin(anim.animation.getSize().x / 2.f,
-                            anim.animation.getSize().y / 2.f);
-            sprite.setScale(0.5f, 0.5f);
-            m_game.window().draw(sprite);
+            batchAnimation(anim.animation, drawPos(transform), LayerFragments, sf::Vector2f(0.5f, 0.5f));
         }
     }
 
     // Render items (collectables)
-    for (auto& item : m_entityManager.getEntities()) {
-        if (item->tag() != "collectable") continue;
+    for (auto& item : m_entityManager.getEntities(TagId::Collectable)) {
+        if (!visible(item)) continue;
         auto& transform = item->get<CTransform>();
         if (item->has<CAnimation>()) {
             auto& anim = item->get<CAnimation>();
-            sf::Sprite sprite = anim.animation.getSprite();
-            sprite.setPosition(transform.pos.x, transform.pos.y);
-            sprite.setOrigin(anim.animation.getSize().x / 2.f,
-                            anim.animation.getSize().y / 2.f);
-            // Apply dark palette if needed
-            //sprite.setColor(darkFilterLevel1);
-            m_game.window().draw(sprite);
+            batchAnimation(anim.animation, drawPos(transform), LayerCollectables);
         }
         if (m_showBoundingBoxes && item->has<CBoundingBox>()) {
             auto& bbox = item->get<CBoundingBox>();
             debugBox.setSize(sf::Vector2f(bbox.size.x, bbox.size.y));
             debugBox.setOrigin(bbox.halfSize.x, bbox.halfSize.y);
-            debugBox.setPosition(transform.pos.x, transform.pos.y);
+            debugBox.setPosition(drawPos(transform).x, drawPos(transform).y);
             debugBox.setFillColor(sf::Color::Transparent);
             debugBox.setOutlineColor(sf::Color::Red);
             debugBox.setOutlineThickness(2.f);
-            m_game.window().draw(debugBox);
+            m_game.frame().draw(debugBox);
         }
     }
 
+    m_spriteBatch.flush(m_game.frame());
+
     // Render player
-    for (auto& player : m_entityManager.getEntities("player")) {
+    for (auto& player : m_entityManager.getEntities(TagId::Player)) {
         auto& transform = player->get<CTransform>();
         if (player->has<CAnimation>()) {
             auto& animation = player->get<CAnimation>();
             sf::Sprite sprite = animation.animation.getSprite();
-            sprite.setPosition(transform.pos.x, transform.pos.y);
+            sprite.setPosition(drawPos(transform).x, drawPos(transform).y);
             sprite.setOrigin(animation.animation.getSize().x / 2.f,
                              animation.animation.getSize().y / 2.f);
-            m_game.window().draw(sprite);
+            m_game.frame().draw(sprite);
         }
         if (m_showBoundingBoxes && player->has<CBoundingBox>()) {
             auto& bbox = player->get<CBoundingBox>();
             debugBox.setSize(sf::Vector2f(bbox.size.x, bbox.size.y));
             debugBox.setOrigin(bbox.halfSize.x, bbox.halfSize.y);
-            debugBox.setPosition(transform.pos.x, transform.pos.y);
+            debugBox.setPosition(drawPos(transform).x, drawPos(transform).y);
             debugBox.setOutlineColor(sf::Color::Green);
             debugBox.setOutlineThickness(2.f);
-            m_game.window().draw(debugBox);
+            m_game.frame().draw(debugBox);
         }
     }
     // Render enemies
-    for (auto& enemy : m_entityManager.getEntities("enemy")) {
+    for (auto& enemy : m_entityManager.getEntities(TagId::Enemy)) {
         if (!enemy->has<CTransform>() || !enemy->has<CHealth>())
             continue;
 
@@ -349,8 +338,11 @@ void PlayRenderer::render() {
             auto& enemyAI = enemy->get<CEnemyAI>();
             isEmperor = (enemyAI.enemyType == EnemyType::Emperor);
         }
+        // The Emperor's animation is picked below: never skip it
+        if (!isEmperor && !visible(enemy)) continue;
 
         // ----- Draw Health Bars -----
+        // Queued on the overlay, flushed once after the enemy loop
         if (isEmperor) {
             // Emperor health bar settings
             float barWidth = 120.f;
@@ -375,8 +367,8 @@ void PlayRenderer::render() {
                 sf::Color(50, 220, 50)     // Top bar (Phase 1)
             };
 
-            float baseX = eTrans.pos.x - (barWidth / 2.f);
-            float baseY = eTrans.pos.y - offsetY;
+            float baseX = drawPos(eTrans).x - (barWidth / 2.f);
+            float baseY = drawPos(eTrans).y - offsetY;
 
             // Draw three stacked bars (top to bottom)
             for (int i = 0; i < 3; i++) {
@@ -384,10 +376,7 @@ void PlayRenderer::render() {
                 float barY = baseY + (2 - i) * (barHeight + spacing);
 
                 // Background
-                sf::RectangleShape healthBg(sf::Vector2f(barWidth, barHeight));
-                healthBg.setFillColor(sf::Color(50, 50, 50));
-                healthBg.setPosition(barX, barY);
-                m_game.window().draw(healthBg);
+                m_overlay.rect({barX, barY, barWidth, barHeight}, sf::Color(50, 50, 50));
 
                 // Calculate fill ratio per bar
                 float fillRatio = 0.f;
@@ -407,61 +396,42 @@ void PlayRenderer::render() {
                 }
 
                 // Filled portion
-                sf::RectangleShape healthRect(sf::Vector2f(barWidth * fillRatio, barHeight));
-                healthRect.setFillColor(barColors[i]);
-                healthRect.setPosition(barX, barY);
-                m_game.window().draw(healthRect);
+                m_overlay.rect({barX, barY, barWidth * fillRatio, barHeight}, barColors[i]);
 
                 // Border
-                sf::RectangleShape borderRect(sf::Vector2f(barWidth, barHeight));
-                borderRect.setFillColor(sf::Color::Transparent);
-                borderRect.setOutlineColor(sf::Color::White);
-                borderRect.setOutlineThickness(1.f);
-                borderRect.setPosition(barX, barY);
-                m_game.window().draw(borderRect);
+                m_overlay.outline({barX, barY, barWidth, barHeight}, sf::Color::White, 1.f);
 
                 // Division markers
                 int divisions = (i == 0) ? 4 : (i == 1) ? 2 : 3;
                 for (int j = 1; j < divisions; j++) {
                     float markerX = barX + (barWidth * j / divisions);
-                    sf::Vertex line[] = {
-                        sf::Vertex(sf::Vector2f(markerX, barY), sf::Color::White),
-                        sf::Vertex(sf::Vector2f(markerX, barY + barHeight), sf::Color::White)
-                    };
-                    m_game.window().draw(line, 2, sf::Lines);
+                    m_overlay.line({markerX, barY}, {markerX, barY + barHeight}, sf::Color::White);
                 }
             }
 
             // Final Attack indicator if health is below phase3 threshold
             if (healthRatio <= phase3Threshold) {
-                sf::RectangleShape finalPhaseBar(sf::Vector2f(barWidth, barHeight));
-                finalPhaseBar.setFillColor(sf::Color(150, 0, 0));
-                finalPhaseBar.setPosition(baseX, baseY + 3 * (barHeight + spacing));
-                m_game.window().draw(finalPhaseBar);
+                float finalBarY = baseY + 3 * (barHeight + spacing);
+                m_overlay.rect({baseX, finalBarY, barWidth, barHeight}, sf::Color(150, 0, 0));
 
                 if (m_game.assets().hasFont("Menu")) {
-                    sf::Text finalText;
-                    finalText.setFont(m_game.assets().getFont("Menu"));
-                    finalText.setString("FINAL ATTACK (<10%)");
-                    finalText.setCharacterSize(12);
-                    finalText.setFillColor(sf::Color::Red);
-                    sf::FloatRect textBounds = finalText.getLocalBounds();
-                    finalText.setPosition(baseX - textBounds.width - 5.f,
-                        baseY + 3 * (barHeight + spacing) + (barHeight / 2.f) - (textBounds.height / 2.f));
-                    m_game.window().draw(finalText);
+                    m_finalAttackText.set(m_game.assets().getFont("Menu"), 12, "FINAL ATTACK (<10%)");
+                    m_finalAttackText.setFillColor(sf::Color::Red);
+                    const sf::FloatRect& textBounds = m_finalAttackText.localBounds();
+                    m_overlay.text(m_finalAttackText,
+                        {baseX - textBounds.width - 5.f,
+                         finalBarY + (barHeight / 2.f) - (textBounds.height / 2.f)});
                 }
             }
 
             // Draw overall health percentage text above the bars
             if (m_game.assets().hasFont("Menu")) {
-                sf::Text healthText;
-                healthText.setFont(m_game.assets().getFont("Menu"));
-                healthText.setString(std::to_string(static_cast<int>(healthRatio * 100)) + "%");
-                healthText.setCharacterSize(14);
-                healthText.setFillColor(sf::Color::White);
-                sf::FloatRect textBounds = healthText.getLocalBounds();
-                healthText.setPosition(baseX + (barWidth / 2.f) - (textBounds.width / 2.f), baseY - 25.f);
-                m_game.window().draw(healthText);
+                m_emperorHealthText.set(m_game.assets().getFont("Menu"), 14,
+                                        std::to_string(static_cast<int>(healthRatio * 100)) + "%");
+                m_emperorHealthText.setFillColor(sf::Color::White);
+                const sf::FloatRect& textBounds = m_emperorHealthText.localBounds();
+                m_overlay.text(m_emperorHealthText,
+                    {baseX + (barWidth / 2.f) - (textBounds.width / 2.f), baseY - 25.f});
             }
         } else if (enemy->get<CEnemyAI>().enemyType == EnemyType::Super || enemy->get<CEnemyAI>().enemyType == EnemyType::Super2) {
             // Super enemy "mystery" health bar
@@ -469,38 +439,25 @@ void PlayRenderer::render() {
             float barHeight = 7.f;  // Slightly taller than regular enemies
             float offsetY = 65.f;
             
-            float barX = eTrans.pos.x - (barWidth / 2.f);
-            float barY = eTrans.pos.y - offsetY;
+            float barX = drawPos(eTrans).x - (barWidth / 2.f);
+            float barY = drawPos(eTrans).y - offsetY;
             
             // Black background
-            sf::RectangleShape healthBg(sf::Vector2f(barWidth, barHeight));
-            healthBg.setFillColor(sf::Color(0, 0, 0));
-            healthBg.setPosition(barX, barY);
-            m_game.window().draw(healthBg);
+            m_overlay.rect({barX, barY, barWidth, barHeight}, sf::Color(0, 0, 0));
             
             // Red border
-            sf::RectangleShape borderRect(sf::Vector2f(barWidth, barHeight));
-            borderRect.setFillColor(sf::Color::Transparent);
-            borderRect.setOutlineColor(sf::Color(200, 0, 0));
-            borderRect.setOutlineThickness(1.5f);
-            borderRect.setPosition(barX, barY);
-            m_game.window().draw(borderRect);
+            m_overlay.outline({barX, barY, barWidth, barHeight}, sf::Color(200, 0, 0), 1.5f);
             
-            // "???" text in the middle
+            // "???" text in the middle (one text shared by all super enemies)
             if (m_game.assets().hasFont("Menu")) {
-                sf::Text mysteryText;
-                mysteryText.setFont(m_game.assets().getFont("Menu"));
-                mysteryText.setString("???");
-                mysteryText.setCharacterSize(12);
-                mysteryText.setFillColor(sf::Color(200, 0, 0));  // Red text
+                m_mysteryText.set(m_game.assets().getFont("Menu"), 12, "???");
+                m_mysteryText.setFillColor(sf::Color(200, 0, 0));  // Red text
                 
-                sf::FloatRect textBounds = mysteryText.getLocalBounds();
-                mysteryText.setPosition(
+                const sf::FloatRect& textBounds = m_mysteryText.localBounds();
+                m_overlay.text(m_mysteryText, {
                     barX + (barWidth / 2.f) - (textBounds.width / 2.f),
                     barY + (barHeight / 2.f) - (textBounds.height / 2.f) - 2.f  // Small offset for better centering
-                );
-                
-                m_game.window().draw(mysteryText);
+                });
             }
         } else {
             // Regular enemy health bar
@@ -511,20 +468,13 @@ void PlayRenderer::render() {
             float maxHealth = eHealth.maxHealth;
             float healthRatio = (maxHealth > 0.f) ? (currentHealth / maxHealth) : 0.f;
             healthRatio = std::clamp(healthRatio, 0.f, 1.f);
-            float barX = eTrans.pos.x - (barWidth / 2.f);
-            float barY = eTrans.pos.y - offsetY;
-            sf::RectangleShape healthBg(sf::Vector2f(barWidth, barHeight));
-            healthBg.setFillColor(sf::Color(50, 50, 50));
-            healthBg.setPosition(barX, barY);
-            m_game.window().draw(healthBg);
+            float barX = drawPos(eTrans).x - (barWidth / 2.f);
+            float barY = drawPos(eTrans).y - offsetY;
+            m_overlay.rect({barX, barY, barWidth, barHeight}, sf::Color(50, 50, 50));
             sf::Color healthColor = (healthRatio > 0.7f) ? sf::Color::Green :
                                     (healthRatio > 0.3f) ? sf::Color::Yellow :
                                     sf::Color::Red;
-            sf::RectangleShape healthRect(sf::Vector2f(barWidth * healthRatio, barHeight));
-            healthRect.setFillColor(healthColor);
-            healthRect.setPosition(barX, barY);
-            
-            m_game.window().draw(healthRect);
+            m_overlay.rect({barX, barY, barWidth * healthRatio, barHeight}, healthColor);
         }
 
         if (enemy->has<CAnimation>()) {
@@ -617,9 +567,9 @@ void PlayRenderer::render() {
                     float scaleX = (enemyAI.facingDirection < 0.f) ? -1.f : 1.f;
                     sf::Sprite sprite = animation.animation.getSprite();
                     sprite.setScale(scaleX, 1.f);
-                    sprite.setPosition(eTrans.pos.x, eTrans.pos.y);
+                    sprite.setPosition(drawPos(eTrans).x, drawPos(eTrans).y);
                     sprite.setOrigin(animation.animation.getSize().x * 0.5f, animation.animation.getSize().y * 0.5f);
-                    m_game.window().draw(sprite);
+                    m_game.frame().draw(sprite);
                 }
         
                 // std::cout << "[DEBUG] Emperor state: " << static_cast<int>(bossPhase)
@@ -636,12 +586,12 @@ void PlayRenderer::render() {
         
                 if (shouldDraw) {
                     sf::Sprite sprite = animation.animation.getSprite();
-                    sprite.setPosition(eTrans.pos);
+                    sprite.setPosition(drawPos(eTrans));
                     sprite.setOrigin(animation.animation.getSize().x * 0.5f, animation.animation.getSize().y * 0.5f);
-                    if (m_game.getCurrentLevel().find("ancient") != std::string::npos) {
-                        sprite.setColor(darkFilterLevel1);
+                    if (m_lighting.enemy) {
+                        sprite.setColor(*m_lighting.enemy);
                     }
-                    m_game.window().draw(sprite);
+                    m_game.frame().draw(sprite);
                 }
             }
         }
@@ -651,186 +601,171 @@ void PlayRenderer::render() {
             auto& bbox = enemy->get<CBoundingBox>();
             debugBox.setSize(sf::Vector2f(bbox.size.x, bbox.size.y));
             debugBox.setOrigin(bbox.halfSize.x, bbox.halfSize.y);
-            debugBox.setPosition(eTrans.pos.x, eTrans.pos.y);
+            debugBox.setPosition(drawPos(eTrans).x, drawPos(eTrans).y);
             debugBox.setOutlineColor(sf::Color::Magenta);
             debugBox.setOutlineThickness(2.f);
-            m_game.window().draw(debugBox);
+            m_game.frame().draw(debugBox);
         }
     }
+    // Enemy health bars go over every enemy sprite
+    m_overlay.flush(m_game.frame());
+
     // Render player sword
-    for (auto& sword : m_entityManager.getEntities("sword")) {
+    for (auto& sword : m_entityManager.getEntities(TagId::Sword)) {
         if (!sword->has<CTransform>()) continue;
         auto& swTrans = sword->get<CTransform>();
         if (sword->has<CAnimation>()) {
             auto& anim = sword->get<CAnimation>();
             sf::Sprite sprite = anim.animation.getSprite();
-            sprite.setPosition(swTrans.pos.x, swTrans.pos.y);
-            m_game.window().draw(sprite);
+            sprite.setPosition(drawPos(swTrans).x, drawPos(swTrans).y);
+            m_game.frame().draw(sprite);
         }
         if (m_showBoundingBoxes && sword->has<CBoundingBox>()) {
             auto& bbox = sword->get<CBoundingBox>();
             debugBox.setSize(sf::Vector2f(bbox.size.x, bbox.size.y));
             debugBox.setOrigin(bbox.halfSize.x, bbox.halfSize.y);
-            debugBox.setPosition(swTrans.pos.x, swTrans.pos.y);
+            debugBox.setPosition(drawPos(swTrans).x, drawPos(swTrans).y);
             debugBox.setFillColor(sf::Color::Transparent);
             debugBox.setOutlineColor(sf::Color::Yellow);
             debugBox.setOutlineThickness(2.f);
-            m_game.window().draw(debugBox);
+            m_game.frame().draw(debugBox);
         }
     }
 
     // Render enemy swords
-    for (auto& esword : m_entityManager.getEntities("enemySword")) {
+    for (auto& esword : m_entityManager.getEntities(TagId::EnemySword)) {
+        if (!visible(esword)) continue;
         if (!esword->has<CTransform>()) continue;
         auto& esTrans = esword->get<CTransform>();
-        //std::cout << "Rendering enemy sword at " << esTrans.pos.x << "," << esTrans.pos.y << "\n";
+        //std::cout << "Rendering enemy sword at " << drawPos(esTrans).x << "," << drawPos(esTrans).y << "\n";
         if (esword->has<CAnimation>()) {
             //std::cout << "Rendering enemy sword\n";
             auto& anim = esword->get<CAnimation>();
-            sf::Sprite sprite = anim.animation.getSprite();
-            sprite.setPosition(esTrans.pos.x, esTrans.pos.y);
-            sprite.setOrigin(anim.animation.getSize().x / 2.f,
-                             anim.animation.getSize().y / 2.f);
-            m_game.window().draw(sprite);
+            batchAnimation(anim.animation, drawPos(esTrans), LayerEnemySwords);
         }
         if (m_showBoundingBoxes && esword->has<CBoundingBox>()) {
             //std::cout << "Rendering enemy sword bounding box\n";
             auto& bbox = esword->get<CBoundingBox>();
             debugBox.setSize(sf::Vector2f(bbox.size.x, bbox.size.y));
-            float dir = (esTrans.pos.x < 0) ? -1.f : 1.f;
+            float dir = (drawPos(esTrans).x < 0) ? -1.f : 1.f;
             debugBox.setOrigin((dir < 0) ? bbox.size.x : bbox.halfSize.x, bbox.halfSize.y);
-            debugBox.setPosition(esTrans.pos.x, esTrans.pos.y);
+            debugBox.setPosition(drawPos(esTrans).x, drawPos(esTrans).y);
             debugBox.setFillColor(sf::Color::Transparent);
             debugBox.setOutlineColor(sf::Color::Yellow);
             debugBox.setOutlineThickness(2.f);
-            m_game.window().draw(debugBox);
+            m_game.frame().draw(debugBox);
         }
     }
 
     // Render enemy swords
-    for (auto& esword : m_entityManager.getEntities("EmperorSword")) {
+    for (auto& esword : m_entityManager.getEntities(TagId::EmperorSword)) {
+        if (!visible(esword)) continue;
         if (!esword->has<CTransform>()) continue;
         auto& esTrans = esword->get<CTransform>();
-        //std::cout << "Rendering enemy sword at " << esTrans.pos.x << "," << esTrans.pos.y << "\n";
+        //std::cout << "Rendering enemy sword at " << drawPos(esTrans).x << "," << drawPos(esTrans).y << "\n";
         if (esword->has<CAnimation>()) {
             //std::cout << "Rendering enemy sword\n";
             auto& anim = esword->get<CAnimation>();
-            sf::Sprite sprite = anim.animation.getSprite();
-            sprite.setPosition(esTrans.pos.x, esTrans.pos.y);
-            sprite.setOrigin(anim.animation.getSize().x / 2.f,
-                                anim.animation.getSize().y / 2.f);
-            m_game.window().draw(sprite);
+            batchAnimation(anim.animation, drawPos(esTrans), LayerEmperorSwords);
         }
         if (m_showBoundingBoxes && esword->has<CBoundingBox>()) {
             //std::cout << "Rendering enemy sword bounding box\n";
             auto& bbox = esword->get<CBoundingBox>();
             debugBox.setSize(sf::Vector2f(bbox.size.x, bbox.size.y));
-            float dir = (esTrans.pos.x < 0) ? -1.f : 1.f;
+            float dir = (drawPos(esTrans).x < 0) ? -1.f : 1.f;
             debugBox.setOrigin((dir < 0) ? bbox.size.x : bbox.halfSize.x, bbox.halfSize.y);
-            debugBox.setPosition(esTrans.pos.x, esTrans.pos.y);
+            debugBox.setPosition(drawPos(esTrans).x, drawPos(esTrans).y);
             debugBox.setFillColor(sf::Color::Transparent);
             debugBox.setOutlineColor(sf::Color::Yellow);
             debugBox.setOutlineThickness(2.f);
-            m_game.window().draw(debugBox);
+            m_game.frame().draw(debugBox);
         }
     }
     
     // Render emperor black holes
-    for (auto& blackHole : m_entityManager.getEntities("emperorBlackHole")) {
+    for (auto& blackHole : m_entityManager.getEntities(TagId::EmperorBlackHole)) {
+        if (!visible(blackHole)) continue;
         if (!blackHole->has<CTransform>()) continue;
         
         auto& blackHoleTrans = blackHole->get<CTransform>();
         
         if (blackHole->has<CAnimation>()) {
             auto& anim = blackHole->get<CAnimation>();
-            sf::Sprite sprite = anim.animation.getSprite();
-            sprite.setPosition(blackHoleTrans.pos.x, blackHoleTrans.pos.y);
-            sprite.setOrigin(anim.animation.getSize().x / 2.f,
-                            anim.animation.getSize().y / 2.f);
-            m_game.window().draw(sprite);
+            batchAnimation(anim.animation, drawPos(blackHoleTrans), LayerBlackHoles);
         }
         
         if (m_showBoundingBoxes && blackHole->has<CBoundingBox>()) {
             auto& bbox = blackHole->get<CBoundingBox>();
             debugBox.setSize(sf::Vector2f(bbox.size.x, bbox.size.y));
-            float dir = (blackHoleTrans.pos.x < 0) ? -1.f : 1.f;
+            float dir = (drawPos(blackHoleTrans).x < 0) ? -1.f : 1.f;
             debugBox.setOrigin((dir < 0) ? bbox.size.x : bbox.halfSize.x, bbox.halfSize.y);
-            debugBox.setPosition(blackHoleTrans.pos.x, blackHoleTrans.pos.y);
+            debugBox.setPosition(drawPos(blackHoleTrans).x, drawPos(blackHoleTrans).y);
             debugBox.setFillColor(sf::Color::Transparent);
             debugBox.setOutlineColor(sf::Color::Magenta); // Different color to distinguish black holes
             debugBox.setOutlineThickness(2.f);
-            m_game.window().draw(debugBox);
+            m_game.frame().draw(debugBox);
         }
     }
 
     // Render enemy swords
-    for (auto& esword : m_entityManager.getEntities("EmperorSwordArmor")) {
+    for (auto& esword : m_entityManager.getEntities(TagId::EmperorSwordArmor)) {
+        if (!visible(esword)) continue;
         if (!esword->has<CTransform>()) continue;
         auto& esTrans = esword->get<CTransform>();
-        //std::cout << "Rendering enemy sword at " << esTrans.pos.x << "," << esTrans.pos.y << "\n";
+        //std::cout << "Rendering enemy sword at " << drawPos(esTrans).x << "," << drawPos(esTrans).y << "\n";
         if (esword->has<CAnimation>()) {
             //std::cout << "Rendering enemy sword\n";
             auto& anim = esword->get<CAnimation>();
-            sf::Sprite sprite = anim.animation.getSprite();
-            sprite.setPosition(esTrans.pos.x, esTrans.pos.y);
-            sprite.setOrigin(anim.animation.getSize().x / 2.f,
-                                anim.animation.getSize().y / 2.f);
-            m_game.window().draw(sprite);
+            batchAnimation(anim.animation, drawPos(esTrans), LayerArmorSwords);
         }
         if (m_showBoundingBoxes && esword->has<CBoundingBox>()) {
             //std::cout << "Rendering enemy sword bounding box\n";
             auto& bbox = esword->get<CBoundingBox>();
             debugBox.setSize(sf::Vector2f(bbox.size.x, bbox.size.y));
-            float dir = (esTrans.pos.x < 0) ? -1.f : 1.f;
+            float dir = (drawPos(esTrans).x < 0) ? -1.f : 1.f;
             debugBox.setOrigin((dir < 0) ? bbox.size.x : bbox.halfSize.x, bbox.halfSize.y);
-            debugBox.setPosition(esTrans.pos.x, esTrans.pos.y);
+            debugBox.setPosition(drawPos(esTrans).x, drawPos(esTrans).y);
             debugBox.setFillColor(sf::Color::Transparent);
             debugBox.setOutlineColor(sf::Color::Yellow);
             debugBox.setOutlineThickness(2.f);
-            m_game.window().draw(debugBox);
+            m_game.frame().draw(debugBox);
         }
     }
     
     // Render enemy grave
-    for (auto& egrave : m_entityManager.getEntities("enemyGrave")) {
+    for (auto& egrave : m_entityManager.getEntities(TagId::EnemyGrave)) {
+        if (!visible(egrave)) continue;
         if (!egrave->has<CTransform>()) continue;
         auto& esTrans = egrave->get<CTransform>();
-        //std::cout << "Rendering enemy sword at " << esTrans.pos.x << "," << esTrans.pos.y << "\n";
+        //std::cout << "Rendering enemy sword at " << drawPos(esTrans).x << "," << drawPos(esTrans).y << "\n";
         if (egrave->has<CAnimation>()) {
             //std::cout << "Rendering enemy sword\n";
             auto& anim = egrave->get<CAnimation>();
-            sf::Sprite sprite = anim.animation.getSprite();
-            sprite.setPosition(esTrans.pos.x, esTrans.pos.y);
-            sprite.setOrigin(anim.animation.getSize().x / 2.f,
-                                anim.animation.getSize().y / 2.f);
-            m_game.window().draw(sprite);
+            batchAnimation(anim.animation, drawPos(esTrans), LayerGraves);
         }
         if (m_showBoundingBoxes && egrave->has<CBoundingBox>()) {
             //std::cout << "Rendering enemy sword bounding box\n";
             auto& bbox = egrave->get<CBoundingBox>();
             debugBox.setSize(sf::Vector2f(bbox.size.x, bbox.size.y));
-            float dir = (esTrans.pos.x < 0) ? -1.f : 1.f;
+            float dir = (drawPos(esTrans).x < 0) ? -1.f : 1.f;
             debugBox.setOrigin((dir < 0) ? bbox.size.x : bbox.halfSize.x, bbox.halfSize.y);
-            debugBox.setPosition(esTrans.pos.x, esTrans.pos.y);
+            debugBox.setPosition(drawPos(esTrans).x, drawPos(esTrans).y);
             debugBox.setFillColor(sf::Color::Transparent);
             debugBox.setOutlineColor(sf::Color::Yellow);
             debugBox.setOutlineThickness(2.f);
-            m_game.window().draw(debugBox);
+            m_game.frame().draw(debugBox);
         }
     }
 
     // Render enemy bullets
-    for (auto& bullet : m_entityManager.getEntities("enemyBullet")) {
+    for (auto& bullet : m_entityManager.getEntities(TagId::EnemyBullet)) {
+        if (!visible(bullet)) continue;
         if (!bullet->has<CTransform>()) continue;
         auto& bulletTrans = bullet->get<CTransform>();
 
         if (bullet->has<CAnimation>()) {
             auto& anim = bullet->get<CAnimation>();
-            sf::Sprite sprite = anim.animation.getSprite();
-            sprite.setPosition(bulletTrans.pos.x, bulletTrans.pos.y);
-            sprite.setOrigin(anim.animation.getSize().x / 2.f,
-                            anim.animation.getSize().y / 2.f);
-            m_game.window().draw(sprite);
+            batchAnimation(anim.animation, drawPos(bulletTrans), LayerEnemyBullets);
         }
 
         if (m_showBoundingBoxes && bullet->has<CBoundingBox>()) {
@@ -838,25 +773,22 @@ void PlayRenderer::render() {
             sf::RectangleShape debugBox;
             debugBox.setSize(sf::Vector2f(bbox.size.x, bbox.size.y));
             debugBox.setOrigin(bbox.halfSize.x, bbox.halfSize.y);
-            debugBox.setPosition(bulletTrans.pos.x, bulletTrans.pos.y);
+            debugBox.setPosition(drawPos(bulletTrans).x, drawPos(bulletTrans).y);
             debugBox.setFillColor(sf::Color::Transparent);
             debugBox.setOutlineColor(sf::Color::Cyan); // Different color for bullets
             debugBox.setOutlineThickness(2.f);
-            m_game.window().draw(debugBox);
+            m_game.frame().draw(debugBox);
         }
     }
-    for (auto& bullet : m_entityManager.getEntities("playerBullet")) {
+    for (auto& bullet : m_entityManager.getEntities(TagId::PlayerBullet)) {
+        if (!visible(bullet)) continue;
         if (!bullet->has<CTransform>()) continue;
         auto& bulletTrans = bullet->get<CTransform>();
     
         // Draw bullet sprite if it has an animation
         if (bullet->has<CAnimation>()) {
             auto& anim = bullet->get<CAnimation>();
-            sf::Sprite sprite = anim.animation.getSprite();
-            sprite.setPosition(bulletTrans.pos.x, bulletTrans.pos.y);
-            sprite.setOrigin(anim.animation.getSize().x * 0.5f,
-                             anim.animation.getSize().y * 0.5f);
-            m_game.window().draw(sprite);
+            batchAnimation(anim.animation, drawPos(bulletTrans), LayerPlayerBullets);
         }
     
         // Draw bounding box if enabled
@@ -865,22 +797,25 @@ void PlayRenderer::render() {
             sf::RectangleShape debugBox;
             debugBox.setSize(sf::Vector2f(bbox.size.x, bbox.size.y));
             debugBox.setOrigin(bbox.halfSize.x, bbox.halfSize.y);
-            debugBox.setPosition(bulletTrans.pos.x, bulletTrans.pos.y);
+            debugBox.setPosition(drawPos(bulletTrans).x, drawPos(bulletTrans).y);
             debugBox.setFillColor(sf::Color::Transparent);
             debugBox.setOutlineColor(sf::Color::Green); // or any color you prefer
             debugBox.setOutlineThickness(2.f);
-            m_game.window().draw(debugBox);
+            m_game.frame().draw(debugBox);
         }
     }
+    m_spriteBatch.flush(m_game.frame());
+
     // --- HUD: Black Bar with Score, Time-of-Day, Health, and Stamina ---
-    m_game.window().setView(defaultView);
+    // Bars and labels go through the overlay: one draw for the rects, and
+    // the labels keep their glyphs until their text changes
+    m_game.frame().setView(defaultView);
     {
+        const sf::Font& menuFont = m_game.assets().getFont("Menu");
+
         // Altezza della barra HUD
         float hudHeight = 80.f;
-        sf::RectangleShape hudBar(sf::Vector2f(static_cast<float>(windowSize.x), hudHeight));
-        hudBar.setFillColor(sf::Color::Black);
-        hudBar.setPosition(0.f, windowSize.y - hudHeight);
-        m_game.window().draw(hudBar);
+        m_overlay.rect({0.f, windowSize.y - hudHeight, static_cast<float>(windowSize.x), hudHeight}, sf::Color::Black);
     
         // Determina l’era (PRESENT, PAST, ALTERED PRESENT) dal worldType
         std::string centerEra;
@@ -906,48 +841,32 @@ void PlayRenderer::render() {
         // ----- LATO SINISTRO: NOME LIVELLO + SCORE -----
         {
             // 1) Nome del livello (es. "ANCIENT ROME (NIGHT)")
-            sf::Text levelText;
-            levelText.setFont(m_game.assets().getFont("Menu"));
-            levelText.setCharacterSize(18);
-            levelText.setFillColor(sf::Color::White);
-            levelText.setString(m_timeofday); 
+            m_hudLevelText.set(menuFont, 18, m_timeofday);
+            m_hudLevelText.setFillColor(sf::Color::White);
             float leftX = 10.f;
             float topY  = windowSize.y - hudHeight + 10.f; 
-            levelText.setPosition(leftX, topY);
-            m_game.window().draw(levelText);
+            m_overlay.text(m_hudLevelText, {leftX, topY});
     
             // 2) Score sotto al nome del livello
-            sf::Text scoreText;
-            scoreText.setFont(m_game.assets().getFont("Menu"));
-            scoreText.setCharacterSize(18);
-            scoreText.setFillColor(sf::Color::White);
-            scoreText.setString("Score: " + std::to_string(m_score));
+            m_hudScoreText.set(menuFont, 18, "Score: " + std::to_string(m_score));
+            m_hudScoreText.setFillColor(sf::Color::White);
             // Più spazio tra level name e score (35 invece di 25)
-            scoreText.setPosition(leftX, topY + 35.f);
-            m_game.window().draw(scoreText);
+            m_overlay.text(m_hudScoreText, {leftX, topY + 35.f});
         }
     
         // ----- CENTRO: ERA (PRESENT, PAST, ALTERED PRESENT) -----
         {
-            sf::Text eraText;
-            eraText.setFont(m_game.assets().getFont("Japanese"));
-            eraText.setCharacterSize(28); // Più grande
-            eraText.setFillColor(sf::Color::White);
-            
-            // Set text with UTF-8 conversion for proper Japanese support
-            eraText.setString(sf::String::fromUtf8(
-                centerEra.begin(),
-                centerEra.end()
-            ));
+            // Japanese font for proper Japanese support
+            m_hudEraText.set(m_game.assets().getFont("Japanese"), 28, centerEra); // Più grande
+            m_hudEraText.setFillColor(sf::Color::White);
     
-            sf::FloatRect textRect = eraText.getLocalBounds();
+            const sf::FloatRect& textRect = m_hudEraText.localBounds();
             float centerX = (windowSize.x - textRect.width) * 0.5f;
             float centerY = windowSize.y - hudHeight + 25.f;
-            eraText.setPosition(centerX, centerY);
-            m_game.window().draw(eraText);
+            m_overlay.text(m_hudEraText, {centerX, centerY});
         }
         // ----- LATO DESTRO: BARRA HEALTH E STAMINA -----
-        auto players = m_entityManager.getEntities("player");
+        auto players = m_entityManager.getEntities(TagId::Player);
         if (!players.empty()) {
             auto& player = players[0];
             if (player->has<CHealth>() && player->has<CState>()) {
@@ -981,10 +900,7 @@ void PlayRenderer::render() {
                 float barY = baseY;
 
                 // Sfondo (grigio)
-                sf::RectangleShape healthBg(sf::Vector2f(barWidth, barHeight));
-                healthBg.setFillColor(sf::Color(50, 50, 50));
-                healthBg.setPosition(barX, barY);
-                m_game.window().draw(healthBg);
+                m_overlay.rect({barX, barY, barWidth, barHeight}, sf::Color(50, 50, 50));
 
                 // Determine color based on health percentage
                 sf::Color healthColor;
@@ -997,21 +913,15 @@ void PlayRenderer::render() {
                 }
 
                 // Riempimento (colore in base a ratio)
-                sf::RectangleShape healthRect(sf::Vector2f(barWidth * healthRatio, barHeight));
-                healthRect.setFillColor(healthColor);
-                healthRect.setPosition(barX, barY);
-                m_game.window().draw(healthRect);
+                m_overlay.rect({barX, barY, barWidth * healthRatio, barHeight}, healthColor);
 
                 // Etichetta "Health" a sinistra della barra
                 {
-                    sf::Text healthLabel;
-                    healthLabel.setFont(m_game.assets().getFont("Menu"));
-                    healthLabel.setCharacterSize(16);
-                    healthLabel.setFillColor(sf::Color::White);
-                    healthLabel.setString("Health");
+                    m_hudHealthLabel.set(menuFont, 16, "Health");
+                    m_hudHealthLabel.setFillColor(sf::Color::White);
 
                     // Calcola bounding box del testo
-                    sf::FloatRect lblRect = healthLabel.getLocalBounds();
+                    const sf::FloatRect& lblRect = m_hudHealthLabel.localBounds();
 
                     // Offset orizzontale a sinistra
                     float offsetX = 15.f; 
@@ -1020,8 +930,7 @@ void PlayRenderer::render() {
                     // Centra verticalmente
                     float labelY  = barY + (barHeight - lblRect.height - offsetY) * 0.5f;
 
-                    healthLabel.setPosition(labelX, labelY);
-                    m_game.window().draw(healthLabel);
+                    m_overlay.text(m_hudHealthLabel, {labelX, labelY});
                 }
                 //---------------------------------------
                 // 2) BARRA STAMINA (facoltativo)
@@ -1031,48 +940,34 @@ void PlayRenderer::render() {
                 float staminaBarY = baseY + barHeight + barSpacing;
 
                 // Sfondo Stamina
-                sf::RectangleShape staminaBg(sf::Vector2f(barWidth, barHeight));
-                staminaBg.setFillColor(sf::Color(50, 50, 50));
-                staminaBg.setPosition(staminaBarX, staminaBarY);
-                m_game.window().draw(staminaBg);
+                m_overlay.rect({staminaBarX, staminaBarY, barWidth, barHeight}, sf::Color(50, 50, 50));
 
                 // Riempimento Stamina (blu)
-                sf::RectangleShape staminaRect(sf::Vector2f(barWidth * staminaRatio, barHeight));
-                staminaRect.setFillColor(sf::Color::Blue);
-                staminaRect.setPosition(staminaBarX, staminaBarY);
-                m_game.window().draw(staminaRect);
+                m_overlay.rect({staminaBarX, staminaBarY, barWidth * staminaRatio, barHeight}, sf::Color::Blue);
 
                 // Etichetta "Stamina" a sinistra
                 {
-                    sf::Text staminaLabel;
-                    staminaLabel.setFont(m_game.assets().getFont("Menu"));
-                    staminaLabel.setCharacterSize(16);
-                    staminaLabel.setFillColor(sf::Color::White);
-                    staminaLabel.setString("Stamina");
+                    m_hudStaminaLabel.set(menuFont, 16, "Stamina");
+                    m_hudStaminaLabel.setFillColor(sf::Color::White);
 
-                    sf::FloatRect lblRect = staminaLabel.getLocalBounds();
+                    const sf::FloatRect& lblRect = m_hudStaminaLabel.localBounds();
                     float offsetX  = 15.f; 
                     float offsetY = 8.f;
                     float labelX   = staminaBarX - (lblRect.width + offsetX);
                     float labelY   = staminaBarY + (barHeight - lblRect.height - offsetY) * 0.5f;
 
-                    staminaLabel.setPosition(labelX, labelY);
-                    m_game.window().draw(staminaLabel);
+                    m_overlay.text(m_hudStaminaLabel, {labelX, labelY});
                 }
 
                 // Se stamina == 0, mostra "No stamina!"
                 if (shieldStamina <= 0.f) {
-                    sf::Text noStaminaText;
-                    noStaminaText.setFont(m_game.assets().getFont("Menu"));
-                    noStaminaText.setCharacterSize(12);
-                    noStaminaText.setFillColor(sf::Color::White);
-                    noStaminaText.setString("No stamina!");
-                    sf::FloatRect textRect = noStaminaText.getLocalBounds();
+                    m_hudNoStaminaText.set(menuFont, 12, "No stamina!");
+                    m_hudNoStaminaText.setFillColor(sf::Color::White);
+                    const sf::FloatRect& textRect = m_hudNoStaminaText.localBounds();
 
                     float textX = staminaBarX + (barWidth - textRect.width)/2.f;
                     float textY = staminaBarY + (barHeight - textRect.height)/2.f;
-                    noStaminaText.setPosition(textX, textY);
-                    m_game.window().draw(noStaminaText);
+                    m_overlay.text(m_hudNoStaminaText, {textX, textY});
                 }
             }
             if (player->has<CPlayerEquipment>() && 
@@ -1099,48 +994,34 @@ void PlayRenderer::render() {
             float ammoBarY = baseY + (barHeight + barSpacing) * 2; // Sotto Health e Stamina
             
             // Sfondo Ammo
-            sf::RectangleShape ammoBg(sf::Vector2f(barWidth, barHeight));
-            ammoBg.setFillColor(sf::Color(50, 50, 50));
-            ammoBg.setPosition(ammoBarX, ammoBarY);
-            m_game.window().draw(ammoBg);
+            m_overlay.rect({ammoBarX, ammoBarY, barWidth, barHeight}, sf::Color(50, 50, 50));
             
             // Riempimento Ammo (giallo/arancione)
-            sf::RectangleShape ammoRect(sf::Vector2f(barWidth * ammoRatio, barHeight));
-            ammoRect.setFillColor(sf::Color(142, 68, 173)); 
-            ammoRect.setPosition(ammoBarX, ammoBarY);
-            m_game.window().draw(ammoRect);
+            m_overlay.rect({ammoBarX, ammoBarY, barWidth * ammoRatio, barHeight}, sf::Color(142, 68, 173));
             
             // Etichetta "Ammo" a sinistra
             {
-                sf::Text ammoLabel;
-                ammoLabel.setFont(m_game.assets().getFont("Menu"));
-                ammoLabel.setCharacterSize(16);
-                ammoLabel.setFillColor(sf::Color::White);
-                ammoLabel.setString("Ammo");
+                m_hudAmmoLabel.set(menuFont, 16, "Ammo");
+                m_hudAmmoLabel.setFillColor(sf::Color::White);
                 
-                sf::FloatRect lblRect = ammoLabel.getLocalBounds();
+                const sf::FloatRect& lblRect = m_hudAmmoLabel.localBounds();
                 float offsetX = 15.f;
                 float offsetY = 8.f;
                 float labelX = ammoBarX - (lblRect.width + offsetX);
                 float labelY = ammoBarY + (barHeight - lblRect.height - offsetY) * 0.5f;
                 
-                ammoLabel.setPosition(labelX, labelY);
-                m_game.window().draw(ammoLabel);
+                m_overlay.text(m_hudAmmoLabel, {labelX, labelY});
             }
             
             // Se l'ammo è esaurito, mostra "No ammo, reloading..."
             if (ammo.currentBullets <= 0) {
-                sf::Text noAmmoText;
-                noAmmoText.setFont(m_game.assets().getFont("Menu"));
-                noAmmoText.setCharacterSize(11);
-                noAmmoText.setFillColor(sf::Color::White);
-                noAmmoText.setString("No ammo, reloading...");
-                sf::FloatRect textRect = noAmmoText.getLocalBounds();
+                m_hudNoAmmoText.set(menuFont, 11, "No ammo, reloading...");
+                m_hudNoAmmoText.setFillColor(sf::Color::White);
+                const sf::FloatRect& textRect = m_hudNoAmmoText.localBounds();
                 
                 float textX = ammoBarX + (barWidth - textRect.width)/2.f;
                 float textY = ammoBarY + (barHeight - textRect.height)/2.f;
-                noAmmoText.setPosition(textX, textY);
-                m_game.window().draw(noAmmoText);
+                m_overlay.text(m_hudNoAmmoText, {textX, textY});
             }
             // ----- SUPER MOVE STATUS -----
             if (player->has<CPlayerEquipment>() && 
@@ -1169,33 +1050,25 @@ void PlayRenderer::render() {
                 }
                 
                 // Positioning to the left of Ammo bar
-                sf::Text superMoveText;
-                superMoveText.setFont(m_game.assets().getFont("Menu"));
-                superMoveText.setCharacterSize(16);
-                superMoveText.setFillColor(statusColor);
-                superMoveText.setString(superMoveStatus);
+                m_hudSuperMoveText.set(menuFont, 16, superMoveStatus);
+                m_hudSuperMoveText.setFillColor(statusColor);
                 
                 // Use the same X position as the "Ammo" label but with adjusted Y
                 float superMoveX = ammoBarX - 300.f; // Position it to the left of the Ammo bar
                 float superMoveY = ammoBarY; // Same height as Ammo bar
                 
-                superMoveText.setPosition(superMoveX, superMoveY);
-                m_game.window().draw(superMoveText);
+                m_overlay.text(m_hudSuperMoveText, {superMoveX, superMoveY});
             }
             // Opzionale: mostra numerici (es. "3 / 6")
             {
-                sf::Text ammoCountText;
-                ammoCountText.setFont(m_game.assets().getFont("Menu"));
-                ammoCountText.setCharacterSize(14);
-                ammoCountText.setFillColor(sf::Color::White);
-                ammoCountText.setString(std::to_string(ammo.currentBullets) + " / " + 
-                                    std::to_string(ammo.maxBullets));
+                m_hudAmmoCountText.set(menuFont, 14, std::to_string(ammo.currentBullets) + " / " + 
+                                                     std::to_string(ammo.maxBullets));
+                m_hudAmmoCountText.setFillColor(sf::Color::White);
                 
-                sf::FloatRect countRect = ammoCountText.getLocalBounds();
+                const sf::FloatRect& countRect = m_hudAmmoCountText.localBounds();
                 float textX = ammoBarX + barWidth + 10.f; // A destra della barra
                 float textY = ammoBarY + (barHeight - countRect.height)/2.f;
-                ammoCountText.setPosition(textX, textY);
-                m_game.window().draw(ammoCountText);
+                m_overlay.text(m_hudAmmoCountText, {textX, textY});
             }
             
             // Se è in ricarica, mostra il progresso
@@ -1204,25 +1077,153 @@ void PlayRenderer::render() {
                 
                 // Barra di progresso ricarica (sotto la barra principale)
                 float progressY = ammoBarY + barHeight + 2.f;
-                sf::RectangleShape reloadBar(sf::Vector2f(barWidth * reloadProgress, 3.f));
-                reloadBar.setFillColor(sf::Color::Yellow);
-                reloadBar.setPosition(ammoBarX, progressY);
-                m_game.window().draw(reloadBar);
+                m_overlay.rect({ammoBarX, progressY, barWidth * reloadProgress, 3.f}, sf::Color::Yellow);
             }
         }
         }
     }
+    m_overlay.flush(m_game.frame());
 
     if (m_dialogueSystem) {
+        TRACE_ZONE("dialogue");
         renderDialogue(m_dialogueSystem);
     }
 
-    m_game.window().setView(m_cameraView);
-    m_game.window().display();
+    // Last, so the overlay counters include the dialogue
+    if (m_showBoundingBoxes) {
+        drawDebugStats();
+    }
+    if (m_showProfiler) {
+        drawProfiler();
+    }
+
+    m_game.frame().setView(m_cameraView);
+}
+
+// Debug counters in the top-left corner (default view), shown with the bounding boxes
+void PlayRenderer::drawDebugStats() {
+    const SpriteBatchStats& batchStats = m_spriteBatch.stats();
+    const OverlayStats& overlayStats = m_overlay.stats();
+    std::string stats = "Broadphase: " + std::to_string(m_collisionStats.proxies) + " bodies, "
+                      + std::to_string(m_collisionStats.candidatePairs) + " candidate pairs, "
+                      + std::to_string(m_collisionStats.narrowphaseTests) + " narrowphase tests, "
+                      + std::to_string(m_collisionStats.contacts) + " contacts ("
+                      + std::to_string(m_collisionStats.newContacts) + " new)\n"
+                      + "Culling: " + std::to_string(m_renderStats.drawn) + " drawn, "
+                      + std::to_string(m_renderStats.culled) + " culled, "
+                      + std::to_string(m_renderStats.chunksComposited) + " static chunks ("
+                      + std::to_string(m_renderStats.chunkRedraws) + " redrawn, "
+                      + std::to_string(m_renderStats.batchCalls) + " tile/decoration draw calls)\n"
+                      + "Sprite batch: " + std::to_string(batchStats.quads) + " quads, "
+                      + std::to_string(batchStats.flushes) + " flushes, "
+                      + std::to_string(batchStats.drawCalls) + " draw calls, "
+                      + std::to_string(batchStats.textureSwitches) + " texture switches\n"
+                      + "Overlay: " + std::to_string(overlayStats.quads) + " quads, "
+                      + std::to_string(overlayStats.drawCalls) + " draw calls, "
+                      + std::to_string(overlayStats.textLayouts) + " text layouts\n"
+                      + "Background: " + std::to_string(m_background.residentTiles()) + "/"
+                      + std::to_string(m_background.totalTiles()) + " tiles resident";
+
+    sf::Text statsText;
+    statsText.setFont(m_game.assets().getFont("Menu"));
+    statsText.setCharacterSize(14);
+    statsText.setFillColor(sf::Color::Yellow);
+    statsText.setString(stats);
+    statsText.setPosition(10.f, 10.f);
+    m_game.frame().draw(statsText);
+}
+
+// Profiler overlay (F3) in the top-right corner (default view): last / average /
+// peak ms of each zone over the profiler's history, a graph of the frame
+// totals, entity counts per tag and this frame's draw calls so far
+void PlayRenderer::drawProfiler() {
+    const Profiler& profiler = m_game.profiler();
+    const sf::Font& font = m_game.assets().getFont("Menu");
+
+    const float width = PROFILER_GRAPH_WIDTH + 20.f;
+    const float left = m_game.frame().getSize().x - width - 10.f;
+    const float top = 10.f;
+    const float lineHeight = font.getLineSpacing(13);
+    const float budgetMs = 1000.f / 60.f;   // one frame at 60 Hz
+
+    std::ostringstream zones;
+    std::ostringstream times;
+    times << std::fixed << std::setprecision(2);
+#if PROFILER_ENABLED
+    zones << "Zone (" << profiler.frames() << " frames)\n";
+    times << "last     avg     peak ms\n";
+#else
+    zones << "Profiler compiled out (PROFILER_ENABLED=0)\n";
+    times << "\n";
+#endif
+    for (size_t index = 0; index < PROFILE_ZONE_COUNT; ++index) {
+        ProfileZone zone = static_cast<ProfileZone>(index);
+        zones << profileZoneName(zone) << "\n";
+        times << std::setw(6) << profiler.sample(zone, 0) << "   "
+              << std::setw(6) << profiler.average(zone) << "   "
+              << std::setw(6) << profiler.peak(zone) << "\n";
+    }
+    zones << "total";
+    times << std::setw(6) << profiler.frameTotal(0);
+
+    const SpriteBatchStats& batchStats = m_spriteBatch.stats();
+    const OverlayStats& overlayStats = m_overlay.stats();
+    std::ostringstream counts;
+    counts << "Draw calls: " << batchStats.drawCalls << " sprite batch, "
+           << m_renderStats.batchCalls << " static, " << overlayStats.drawCalls << " overlay ("
+           << m_game.frame().commandCount() << " recorded commands)\n"
+           << "Entities: " << m_entityManager.getEntities().size();
+    int column = 0;
+    for (size_t index = 0; index < TAG_COUNT; ++index) {
+        size_t count = m_entityManager.countEntities(static_cast<TagId>(index));
+        if (count == 0) continue;
+        counts << (column++ % 3 == 0 ? "\n" : ", ") << tagName(static_cast<TagId>(index)) << " " << count;
+    }
+
+    m_profilerZoneText.set(font, 13, zones.str());
+    m_profilerZoneText.setFillColor(sf::Color::White);
+    m_profilerTimeText.set(font, 13, times.str());
+    m_profilerTimeText.setFillColor(sf::Color::Yellow);
+    m_profilerCountText.set(font, 13, counts.str());
+    m_profilerCountText.setFillColor(sf::Color::White);
+
+    const float tableHeight = (PROFILE_ZONE_COUNT + 2) * lineHeight;
+    const float graphTop = top + tableHeight + 10.f;
+    const float countsTop = graphTop + PROFILER_GRAPH_HEIGHT + 10.f;
+    const float height = countsTop - top + m_profilerCountText.localBounds().height + 20.f;
+    m_overlay.rect({left, top, width, height}, sf::Color(0, 0, 0, 180));
+
+    // Average of each zone as a bar behind its row, full width = the frame budget
+    for (size_t index = 0; index < PROFILE_ZONE_COUNT; ++index) {
+        float fraction = std::min(profiler.average(static_cast<ProfileZone>(index)) / budgetMs, 1.f);
+        if (fraction <= 0.f) continue;
+        m_overlay.rect({left + 10.f, top + 10.f + (index + 1) * lineHeight, PROFILER_GRAPH_WIDTH * fraction, lineHeight - 2.f},
+                       sf::Color(80, 160, 255, 90));
+    }
+
+    // Frame totals, oldest on the left; the line across is the budget
+    const float graphLeft = left + 10.f;
+    const float graphBottom = graphTop + PROFILER_GRAPH_HEIGHT;
+    auto graphY = [&](float ms) { return graphBottom - std::min(ms / (2.f * budgetMs), 1.f) * PROFILER_GRAPH_HEIGHT; };
+    m_overlay.rect({graphLeft, graphTop, PROFILER_GRAPH_WIDTH, PROFILER_GRAPH_HEIGHT}, sf::Color(40, 40, 40, 160));
+    m_overlay.line({graphLeft, graphY(budgetMs)}, {graphLeft + PROFILER_GRAPH_WIDTH, graphY(budgetMs)},
+                   sf::Color(255, 80, 80, 160));
+    const size_t frames = profiler.frames();
+    const float step = PROFILER_GRAPH_WIDTH / static_cast<float>(Profiler::HISTORY - 1);
+    for (size_t age = 1; age < frames; ++age) {
+        float x = graphLeft + PROFILER_GRAPH_WIDTH - age * step;
+        m_overlay.line({x, graphY(profiler.frameTotal(age))}, {x + step, graphY(profiler.frameTotal(age - 1))},
+                       sf::Color::Green);
+    }
+
+    m_overlay.text(m_profilerZoneText, {left + 10.f, top + 10.f});
+    m_overlay.text(m_profilerTimeText, {left + width - 200.f, top + 10.f});
+    m_overlay.text(m_profilerCountText, {left + 10.f, countsTop});
+    m_overlay.flush(m_game.frame());
 }
 
 void PlayRenderer::drawGrid() {
-    int windowHeight = m_game.window().getSize().y;
+    int windowHeight = m_game.frame().getSize().y;
     const int gridSize = 96;
     const int worldWidth = 120;
     const int worldHeight = 40;
@@ -1233,7 +1234,7 @@ void PlayRenderer::drawGrid() {
             sf::Vertex(sf::Vector2f(x * gridSize, windowHeight - (worldHeight * gridSize)), gridColor),
             sf::Vertex(sf::Vector2f(x * gridSize, windowHeight), gridColor)
         };
-        m_game.window().draw(line, 2, sf::Lines);
+        m_game.frame().draw(line, 2, sf::Lines);
     }
 
     for (int y = 0; y <= worldHeight; ++y) {
@@ -1241,7 +1242,7 @@ void PlayRenderer::drawGrid() {
             sf::Vertex(sf::Vector2f(0, windowHeight - (y * gridSize)), gridColor),
             sf::Vertex(sf::Vector2f(worldWidth * gridSize, windowHeight - (y * gridSize)), gridColor)
         };
-        m_game.window().draw(line, 2, sf::Lines);
+        m_game.frame().draw(line, 2, sf::Lines);
     }
 
     const sf::Font& font = m_game.assets().getFont("Menu");
@@ -1253,7 +1254,7 @@ void PlayRenderer::drawGrid() {
             coordText.setFillColor(sf::Color::White);
             coordText.setString(std::to_string(x) + "," + std::to_string(y));
             coordText.setPosition(x * gridSize + 4, windowHeight - (y * gridSize) - gridSize + 4);
-            m_game.window().draw(coordText);
+            m_game.frame().draw(coordText);
         }
     }
 }
@@ -1263,5 +1264,5 @@ void PlayRenderer::drawDebugLine(const Vec2<float>& start, const Vec2<float>& en
         sf::Vertex(sf::Vector2f(start.x, start.y), color),
         sf::Vertex(sf::Vector2f(end.x, end.y), color)
     };
-    m_game.window().draw(line, 2, sf::Lines);
+    m_game.frame().draw(line, 2, sf::Lines);
 }
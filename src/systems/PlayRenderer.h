@@ -6,6 +6,15 @@
 #include "GameEngine.h"
 #include "Vec2.hpp"         // Make sure to include Vec2 definition
 #include "Components.hpp"   // For CTransform, CAnimation, CBoundingBox, etc.
+#include "Broadphase.h"     // CollisionStats
+#include "TileGrid.hpp"
+#include "StaticBatch.h"    // RenderStats
+#include "LayerCompositor.h"
+#include "SpriteBatch.h"
+#include "OverlayBatch.h"
+#include "Lighting.h"
+#include "ParallaxBackground.h"
+#include <optional>
 
 class CAnimation; // Forward declaration if necessary
 
@@ -16,16 +25,51 @@ public:
     // Constructor: receives necessary references for rendering
     PlayRenderer(GameEngine& game,
                  EntityManager& entityManager,
-                 sf::Sprite& backgroundSprite,
-                 sf::Texture& backgroundTexture,
+                 ParallaxBackground& background,
                  sf::View& cameraView,
-                 int& score);
+                 int& score,
+                 const TileGrid& tileGrid);
+
+    // Sprites can stick out of their bounding boxes and health bars sit above
+    // the enemies: the culling rect is the view grown by this much
+    static constexpr float CULL_MARGIN = 2.f * TileGrid::CELL_SIZE;
+
+    // Sprite batch layers, in draw order (fragments and collectables are
+    // flushed before the player, the rest after the enemies)
+    enum SpriteLayer {
+        LayerFragments,
+        LayerCollectables,
+        LayerEnemySwords,
+        LayerEmperorSwords,
+        LayerBlackHoles,
+        LayerArmorSwords,
+        LayerGraves,
+        LayerEnemyBullets,
+        LayerPlayerBullets
+    };
+
+    // Rect of the entity's current animation frame, centred on where it is drawn
+    bool spriteBounds(Entity* entity, sf::FloatRect& rect) const;
+
+    // Moves longer than this in one step are teleports: drawn where they land
+    static constexpr float SNAP_DISTANCE = 2.f * TileGrid::CELL_SIZE;
+    // Profiler overlay frame graph: one pixel per frame of history
+    static constexpr float PROFILER_GRAPH_WIDTH = static_cast<float>(Profiler::HISTORY);
+    static constexpr float PROFILER_GRAPH_HEIGHT = 60.f;
+    // `alpha` of the way from `from` to `to`, or `to` after a teleport
+    static sf::Vector2f interpolate(sf::Vector2f from, sf::Vector2f to, float alpha);
+    // Where an entity is drawn: between its last two fixed steps
+    Vec2<float> drawPos(const CTransform& transform) const;
 
     // Setters for configuration variables
     void setShowGrid(bool show);
     void setShowBoundingBoxes(bool show);
+    void setShowProfiler(bool show) { m_showProfiler = show; }
     void setScore(int score);
     void setTimeOfDay(const std::string& tod);
+    void setCollisionStats(const CollisionStats& stats) { m_collisionStats = stats; }
+    void setLighting(const LightingProfile& lighting) { m_lighting = lighting; }
+    void setInterpolation(float alpha) { m_interpolation = alpha; }
 
     // Main rendering function (equivalent to sRender)
     void render();
@@ -33,6 +77,11 @@ public:
     // Utility functions
     void drawGrid();
     void drawDebugLine(const Vec2<float>& start, const Vec2<float>& end, sf::Color color);
+    void drawDebugStats();
+    void drawProfiler();
+    bool visible(Entity* entity);
+    void batchAnimation(const Animation& animation, const Vec2<float>& pos, int layer,
+                        std::optional<sf::Vector2f> scale = std::nullopt);
     void flipSpriteLeft(CAnimation& canim);
     void flipSpriteRight(CAnimation& canim);
     void setDialogueSystem(DialogueSystem* dialogueSystem) { m_dialogueSystem = dialogueSystem; }
@@ -41,15 +90,49 @@ public:
 private:
     GameEngine& m_game;
     EntityManager& m_entityManager;
-    sf::Sprite& m_backgroundSprite;
-    sf::Texture& m_backgroundTexture;
+    ParallaxBackground& m_background;
     sf::View& m_cameraView;
+    const TileGrid& m_tileGrid;
 
     // Configuration variables for rendering
     bool m_showGrid;
     bool m_showBoundingBoxes;
+    bool m_showProfiler = false;
     int m_score;
     std::string m_timeofday;
+    CollisionStats m_collisionStats;
+    LightingProfile m_lighting;             // set by Scene_Play::init for each level
+    float m_interpolation = 1.f;            // GameEngine::interpolation() of this frame
+
+    sf::FloatRect m_cullRect;               // world rect drawn this frame
+    RenderStats m_renderStats;
+    std::vector<Entity*> m_visibleEntities; // grid query buffer
+    StaticBatch m_decorationBatch;          // built on the first frame of a level
+    StaticBatch m_tileBatch;
+    LayerCompositor m_staticLayers;         // caches both batches in chunk textures
+    SpriteBatch m_spriteBatch;              // bullets, swords, black holes, fragments...
+    OverlayBatch m_overlay;                 // health bars, HUD and dialogue text
+
+    // Overlay texts, kept across frames so their glyphs are only rebuilt on change
+    CachedText m_emperorHealthText;
+    CachedText m_finalAttackText;
+    CachedText m_mysteryText;               // "???" over every super enemy
+    CachedText m_hudLevelText;
+    CachedText m_hudScoreText;
+    CachedText m_hudEraText;
+    CachedText m_hudHealthLabel;
+    CachedText m_hudStaminaLabel;
+    CachedText m_hudNoStaminaText;
+    CachedText m_hudAmmoLabel;
+    CachedText m_hudNoAmmoText;
+    CachedText m_hudSuperMoveText;
+    CachedText m_hudAmmoCountText;
+    CachedText m_dialogueSpeakerText;
+    CachedText m_dialogueMessageText;
+    CachedText m_dialogueContinueText;
+    CachedText m_profilerZoneText;          // profiler overlay columns (F3)
+    CachedText m_profilerTimeText;
+    CachedText m_profilerCountText;
 
     DialogueSystem* m_dialogueSystem = nullptr;
 };
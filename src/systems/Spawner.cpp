@@ -1,17 +1,16 @@
 #include "Spawner.h"
 #include "SpriteUtils.h"
 #include <iostream>
-#include <random>
 #include <cstdlib> 
 #include <ctime>  
 
-Spawner::Spawner(GameEngine& game, EntityManager& entityManager)
-    : m_game(game), m_entityManager(entityManager)
+Spawner::Spawner(GameEngine& game, EntityManager& entityManager, const TileGrid& tileGrid)
+    : m_game(game), m_entityManager(entityManager), m_tileGrid(tileGrid)
 {
 }
 
-std::shared_ptr<Entity> Spawner::spawnSword(std::shared_ptr<Entity> player) {
-    auto sword = m_entityManager.addEntity("sword");
+Entity* Spawner::spawnSword(Entity* player) {
+    auto sword = m_entityManager.addEntity(TagId::Sword);
     auto& pTrans = player->get<CTransform>();
     sword->add<CTransform>(pTrans.pos);
     sword->add<CLifeSpan>(PLAYER_SWORD_DURATION);
@@ -30,9 +29,9 @@ std::shared_ptr<Entity> Spawner::spawnSword(std::shared_ptr<Entity> player) {
     }
     return sword;
 }
-std::shared_ptr<Entity> Spawner::spawnPlayerBullet(std::shared_ptr<Entity> player) {
+Entity* Spawner::spawnPlayerBullet(Entity* player) {
     // Create the bullet entity
-    auto bullet = m_entityManager.addEntity("playerBullet");
+    auto bullet = m_entityManager.addEntity(TagId::PlayerBullet);
 
     // Get player's transform to figure out where to spawn the bullet
     if (!player->has<CTransform>()) {
@@ -54,7 +53,7 @@ std::shared_ptr<Entity> Spawner::spawnPlayerBullet(std::shared_ptr<Entity> playe
 
     // Generate a random angle within a specified range
     float randomAngleRange = 0.12f; // approx 15 degrees in radians
-    float randomAngle = ((static_cast<float>(rand()) / static_cast<float>(RAND_MAX)) * 2.0f - 1.0f) * randomAngleRange;
+    float randomAngle = m_game.random().floatIn(-1.f, 1.f) * randomAngleRange;
 
     // Add a sanity check to ensure valid facing direction
     if (facingDir == 0.0f) {
@@ -104,8 +103,8 @@ std::shared_ptr<Entity> Spawner::spawnPlayerBullet(std::shared_ptr<Entity> playe
     return bullet;
 }
 
-std::shared_ptr<Entity> Spawner::spawnEnemyBullet(std::shared_ptr<Entity> enemy) {
-    auto bullet = m_entityManager.addEntity("enemyBullet");
+Entity* Spawner::spawnEnemyBullet(Entity* enemy) {
+    auto bullet = m_entityManager.addEntity(TagId::EnemyBullet);
 
     // Copy relevant data from the enemy
     if (enemy->has<CEnemyAI>()) {
@@ -183,8 +182,8 @@ std::shared_ptr<Entity> Spawner::spawnEnemyBullet(std::shared_ptr<Entity> enemy)
 
 
 // Spawn della spada del nemico
-std::shared_ptr<Entity> Spawner::spawnEnemySword(std::shared_ptr<Entity> enemy) {
-    auto sword = m_entityManager.addEntity("enemySword");
+Entity* Spawner::spawnEnemySword(Entity* enemy) {
+    auto sword = m_entityManager.addEntity(TagId::EnemySword);
     auto& enemyAI = enemy->get<CEnemyAI>();
     auto& eTrans = enemy->get<CTransform>();
 
@@ -233,8 +232,8 @@ std::shared_ptr<Entity> Spawner::spawnEnemySword(std::shared_ptr<Entity> enemy)
     return sword;
 }
 
-std::shared_ptr<Entity> Spawner::spawnEmperorSwordOffset(std::shared_ptr<Entity> enemy) {
-    auto sword = m_entityManager.addEntity("EmperorSword");
+Entity* Spawner::spawnEmperorSwordOffset(Entity* enemy) {
+    auto sword = m_entityManager.addEntity(TagId::EmperorSword);
 
     auto& eTrans = enemy->get<CTransform>();
     auto& eAI    = enemy->get<CEnemyAI>();
@@ -245,10 +244,7 @@ std::shared_ptr<Entity> Spawner::spawnEmperorSwordOffset(std::shared_ptr<Entity>
     float offsetX = (dir < 0) ? -EMPEROR_SWORD_OFFSET_X : EMPEROR_SWORD_OFFSET_X;
 
     // Random Y offset between 0 and 80
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> distY(0.f, 80.f);
-    float offsetY = distY(gen);
+    float offsetY = m_game.random().floatIn(0.f, 80.f);
 
     Vec2<float> swordPos = eTrans.pos + Vec2<float>(offsetX, offsetY);
     sword->add<CTransform>(swordPos);
@@ -282,14 +278,14 @@ std::shared_ptr<Entity> Spawner::spawnEmperorSwordOffset(std::shared_ptr<Entity>
     return sword;
 }
 
-void Spawner::spawnEmperorSwordsRadial(std::shared_ptr<Entity> enemy, int swordCount, float radius, float swordSpeed) {
+void Spawner::spawnEmperorSwordsRadial(Entity* enemy, int swordCount, float radius, float swordSpeed) {
     auto& eTrans = enemy->get<CTransform>();
 
     float centerX = eTrans.pos.x;
     float centerY = eTrans.pos.y;
 
     // Generate a random angle offset for this burst (between 0 and 60 degrees)
-    float randomAngleOffset = (std::rand() % 60); 
+    float randomAngleOffset = m_game.random().below(60); 
 
     for (int i = 0; i < swordCount; i++) {
         // Apply random offset to the base angle calculation
@@ -302,7 +298,7 @@ void Spawner::spawnEmperorSwordsRadial(std::shared_ptr<Entity> enemy, int swordC
         Vec2<float> spawnPos(centerX + offsetX, centerY + offsetY);
 
         // Create EmperorSword entity but mark it as radial
-        auto sword = m_entityManager.addEntity("EmperorSword");
+        auto sword = m_entityManager.addEntity(TagId::EmperorSword);
         sword->add<CTransform>(spawnPos);
         sword->add<CLifeSpan>(EMPEROR_ROTATING_SWORD_DURATION);
         
@@ -347,7 +343,7 @@ void Spawner::spawnEmperorSwordsRadial(std::shared_ptr<Entity> enemy, int swordC
 }
 
 void Spawner::spawnEnemyGrave(const Vec2<float>& position, bool isEmperor) {
-    auto grave = m_entityManager.addEntity("enemyGrave");
+    auto grave = m_entityManager.addEntity(TagId::EnemyGrave);
 
     // Offset to spawn at the top of the enemy
     float spawnHeightOffset = 96;
@@ -371,14 +367,14 @@ void Spawner::spawnEnemyGrave(const Vec2<float>& position, bool isEmperor) {
     //           << " grave at (" << spawnPos.x << ", " << spawnPos.y << "), affected by gravity.\n";
 }
 
-void Spawner::spawnEmperorSwordArmorRadial(std::shared_ptr<Entity> enemy, int swordCount, float radius, float swordSpeed, float initialStopTime, float stopTimeIncrement)
+void Spawner::spawnEmperorSwordArmorRadial(Entity* enemy, int swordCount, float radius, float swordSpeed, float initialStopTime, float stopTimeIncrement)
 {
     auto& eTrans = enemy->get<CTransform>();
     float centerX = eTrans.pos.x;
     float centerY = eTrans.pos.y;
 
     // Generate random angle offset for visual variety
-    float randomAngleOffset = (std::rand() % 60);
+    float randomAngleOffset = m_game.random().below(60);
 
     for (int i = 0; i < swordCount; i++) {
         float angleDeg = (360.f / swordCount) * i + randomAngleOffset;
@@ -388,7 +384,7 @@ void Spawner::spawnEmperorSwordArmorRadial(std::shared_ptr<Entity> enemy, int sw
         float offsetY = std::sin(angleRad) * radius;
         Vec2<float> spawnPos(centerX + offsetX, centerY + offsetY);
 
-        auto sword = m_entityManager.addEntity("EmperorSwordArmor");
+        auto sword = m_entityManager.addEntity(TagId::EmperorSwordArmor);
         sword->add<CTransform>(spawnPos);
         sword->add<CLifeSpan>(EMPEROR_ROTATING_SWORD_DURATION);
 
@@ -433,9 +429,7 @@ void Spawner::spawnEmperorSwordArmorRadial(std::shared_ptr<Entity> enemy, int sw
 }
 
 // Item spawning function
-std::shared_ptr<Entity> Spawner::spawnItem(const Vec2<float>& position, const std::string& tileType) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+Entity* Spawner::spawnItem(const Vec2<float>& position, const std::string& tileType) {
     std::string itemName;
     Vec2<float> spawnPos = position;
 
@@ -446,8 +440,7 @@ std::shared_ptr<Entity> Spawner::spawnItem(const Vec2<float>& position, const st
         //  3) SmallGrape - 40%
         //  4) SmallChicken - 30%
         //  5) No item - 10%
-        std::uniform_int_distribution<int> dist(0, 99);
-        int roll = dist(gen);
+        int roll = m_game.random().below(100);
 
         if (roll < 10) {
             itemName = m_game.worldType + "CoinBronze";
@@ -468,8 +461,7 @@ std::shared_ptr<Entity> Spawner::spawnItem(const Vec2<float>& position, const st
         //  2) BigGrape - 40%
         //  3) BigChicken - 40%
         // std::cout << "Hit treasure box\n";
-        std::uniform_int_distribution<int> dist(0, 99);
-        int roll = dist(gen);
+        int roll = m_game.random().below(100);
 
         if (roll < 20) {
             itemName = m_game.worldType + "CoinGold";
@@ -487,7 +479,7 @@ std::shared_ptr<Entity> Spawner::spawnItem(const Vec2<float>& position, const st
     }
 
     // If itemName is set, create the entity
-    auto item = m_entityManager.addEntity("collectable");
+    auto item = m_entityManager.addEntity(TagId::Collectable);
     item->add<CTransform>(spawnPos);
 
     // Load the animation associated with the item
@@ -516,7 +508,7 @@ std::shared_ptr<Entity> Spawner::spawnItem(const Vec2<float>& position, const st
 }
 
 void Spawner::updateFragments(float deltaTime) {
-    for (auto& fragment : m_entityManager.getEntities("fragment")) {
+    for (auto& fragment : m_entityManager.getEntities(TagId::Fragment)) {
         auto& transform = fragment->get<CTransform>();
         auto& anim      = fragment->get<CAnimation>();
         auto& lifespan  = fragment->get<CLifeSpan>();
@@ -536,7 +528,7 @@ void Spawner::updateFragments(float deltaTime) {
 }
 
 void Spawner::updateGraves(float deltaTime) {
-    for (auto& grave : m_entityManager.getEntities("enemyGrave")) {
+    for (auto& grave : m_entityManager.getEntities(TagId::EnemyGrave)) {
         auto& transform = grave->get<CTransform>();
         auto& velocity  = transform.velocity;
         float gravity   = grave->has<CGravity>() ? grave->get<CGravity>().gravity : 1000.f;
@@ -546,20 +538,10 @@ void Spawner::updateGraves(float deltaTime) {
         velocity.y = std::min(velocity.y, 800.f); // Clamp to avoid high speed
 
         // Check collision with ground
-        bool onGround = false;
-        for (auto& tile : m_entityManager.getEntities("tile")) {
-            if (!tile->has<CTransform>() || !tile->has<CBoundingBox>()) continue;
-
-            auto& tileTrans = tile->get<CTransform>();
-            auto& tileBB    = tile->get<CBoundingBox>();
-            sf::FloatRect tileRect = tileBB.getRect(tileTrans.pos);
-            sf::FloatRect graveRect = grave->get<CBoundingBox>().getRect(transform.pos + velocity * deltaTime);
-
-            if (tileRect.intersects(graveRect)) {
-                onGround = true;
-                transform.velocity.y = 0.f;
-                break;
-            }
+        sf::FloatRect graveRect = grave->get<CBoundingBox>().getRect(transform.pos + velocity * deltaTime);
+        bool onGround = m_tileGrid.any(graveRect);
+        if (onGround) {
+            transform.velocity.y = 0.f;
         }
 
         if (!onGround) {
@@ -578,13 +560,8 @@ void Spawner::createBlockFragments(const Vec2<float>& position, const std::strin
         {-1,  1}, {0,  1}, {1,  1}
     };
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> angleDist(FRAGMENT_ANGLE_MIN, FRAGMENT_ANGLE_MAX);
-    std::uniform_int_distribution<int> rotationSpeedDist(FRAGMENT_ROTATION_SPEED_MIN, FRAGMENT_ROTATION_SPEED_MAX);
-
     for (auto dir : directions) {
-        auto fragment = m_entityManager.addEntity("fragment");
+        auto fragment = m_entityManager.addEntity(TagId::Fragment);
         fragment->add<CTransform>(position, Vec2<float>(dir.x * FRAGMENT_SPREAD_SPEED, dir.y * FRAGMENT_SPREAD_SPEED));
 
         if (m_game.assets().hasAnimation(blockType)) {
@@ -599,13 +576,16 @@ void Spawner::createBlockFragments(const Vec2<float>& position, const std::strin
             std::cerr << "[ERROR] Missing animation for fragments: " << blockType << "\n";
         }
 
-        fragment->add<CRotation>(angleDist(gen), rotationSpeedDist(gen));
+        // Drawn one after the other: argument evaluation order is unspecified
+        int angle = m_game.random().intIn(FRAGMENT_ANGLE_MIN, FRAGMENT_ANGLE_MAX);
+        int rotationSpeed = m_game.random().intIn(FRAGMENT_ROTATION_SPEED_MIN, FRAGMENT_ROTATION_SPEED_MAX);
+        fragment->add<CRotation>(angle, rotationSpeed);
         fragment->add<CLifeSpan>(FRAGMENT_DURATION);
     }
 }
 
 // Spawns bullets in a radial pattern around the Emperor
-void Spawner::spawnEmperorBulletsRadial(std::shared_ptr<Entity> enemy, int bulletCount, 
+void Spawner::spawnEmperorBulletsRadial(Entity* enemy, int bulletCount, 
                                      float radius, float bulletSpeed, const std::string& bulletType) {
     auto& eTrans = enemy->get<CTransform>();
 
@@ -613,7 +593,7 @@ void Spawner::spawnEmperorBulletsRadial(std::shared_ptr<Entity> enemy, int bulle
     float centerY = eTrans.pos.y;
 
     // Generate a random angle offset for this burst (between 0 and 60 degrees)
-    float randomAngleOffset = (std::rand() % 60); 
+    float randomAngleOffset = m_game.random().below(60); 
 
     for (int i = 0; i < bulletCount; i++) {
         // Apply random offset to the base angle calculation
@@ -626,7 +606,7 @@ void Spawner::spawnEmperorBulletsRadial(std::shared_ptr<Entity> enemy, int bulle
         Vec2<float> spawnPos(centerX + offsetX, centerY + offsetY);
 
         // Create enemyBullet entity
-        auto bullet = m_entityManager.addEntity("enemyBullet");
+        auto bullet = m_entityManager.addEntity(TagId::EnemyBullet);
         bullet->add<CTransform>(spawnPos);
         bullet->add<CLifeSpan>(3.0f); // Bullet lifespan
         
@@ -639,7 +619,7 @@ void Spawner::spawnEmperorBulletsRadial(std::shared_ptr<Entity> enemy, int bulle
         
         if (bulletType == "Random") {
             // Random bullets for final phase or mixed attacks
-            int randType = std::rand() % 4; // 0-3: Normal, Fast, Strong, Elite
+            int randType = m_game.random().below(4); // 0-3: Normal, Fast, Strong, Elite
             switch (randType) {
                 case 0: animName = "FutureGoldBullet"; break;  // Normal
                 case 1: animName = "FutureBlueBullet"; break;  // Fast
@@ -687,14 +667,14 @@ void Spawner::spawnEmperorBulletsRadial(std::shared_ptr<Entity> enemy, int bulle
 }
 
 // Spawns black holes in multiple directions that destroy tiles on impact
-void Spawner::spawnEmperorBlackHoles(std::shared_ptr<Entity> enemy, int blackHoleCount, 
+void Spawner::spawnEmperorBlackHoles(Entity* enemy, int blackHoleCount, 
                                      float radius, float blackHoleSpeed) {
     auto& eTrans = enemy->get<CTransform>();
 
     float centerX = eTrans.pos.x;
     float centerY = eTrans.pos.y;
 
-    float randomAngleOffset = (std::rand() % 36); 
+    float randomAngleOffset = m_game.random().below(36); 
 
     for (int i = 0; i < blackHoleCount; i++) {
         float angleDeg = (360.f / blackHoleCount) * i + randomAngleOffset;
@@ -706,7 +686,7 @@ void Spawner::spawnEmperorBlackHoles(std::shared_ptr<Entity> enemy, int blackHol
         Vec2<float> spawnPos(centerX + offsetX, centerY + offsetY);
 
         // Create blackHole entity
-        auto blackHole = m_entityManager.addEntity("emperorBlackHole");
+        auto blackHole = m_entityManager.addEntity(TagId::EmperorBlackHole);
         blackHole->add<CTransform>(spawnPos);
         blackHole->add<CLifeSpan>(5.0f); // Black hole lifespan - longer than bullets
         
@@ -743,7 +723,7 @@ void Spawner::spawnEmperorBlackHoles(std::shared_ptr<Entity> enemy, int blackHol
 }
 
 // Overload without bulletType for backward compatibility
-void Spawner::spawnEmperorBulletsRadial(std::shared_ptr<Entity> enemy, int bulletCount, 
+void Spawner::spawnEmperorBulletsRadial(Entity* enemy, int bulletCount, 
                                       float radius, float bulletSpeed) {
     // Default to random bullets if no type specified
     spawnEmperorBulletsRadial(enemy, bulletCount, radius, bulletSpeed, "Random");
@@ -1,6 +1,7 @@
 #pragma once
 #include "GameEngine.h"
 #include "EntityManager.hpp"
+#include "TileGrid.hpp"
 #include "Entity.hpp"
 #include "Components.hpp"
 #include "Animation.hpp"
@@ -82,38 +83,39 @@ public:
     static constexpr float BULLET_BLACK_SCALE = 1.3f;
     static constexpr float BULLET_DURATION= 10.f;
 
-    Spawner(GameEngine& game, EntityManager& entityManager);
+    Spawner(GameEngine& game, EntityManager& entityManager, const TileGrid& tileGrid);
 
     // Spawn functions
-    std::shared_ptr<Entity> spawnSword(std::shared_ptr<Entity> player);
-    std::shared_ptr<Entity> spawnEnemySword(std::shared_ptr<Entity> enemy);
-    std::shared_ptr<Entity> spawnEnemyBullet(std::shared_ptr<Entity> enemy); // Added
+    Entity* spawnSword(Entity* player);
+    Entity* spawnEnemySword(Entity* enemy);
+    Entity* spawnEnemyBullet(Entity* enemy); // Added
     
-    std::shared_ptr<Entity> spawnItem(const Vec2<float>& position, const std::string& tileType);
-    std::shared_ptr<Entity> spawnEmperorSwordOffset(std::shared_ptr<Entity> enemy);
-    std::shared_ptr<Entity> spawnPlayerBullet(std::shared_ptr<Entity> player);
+    Entity* spawnItem(const Vec2<float>& position, const std::string& tileType);
+    Entity* spawnEmperorSwordOffset(Entity* enemy);
+    Entity* spawnPlayerBullet(Entity* player);
 
 
-    void spawnEmperorSwordsRadial(std::shared_ptr<Entity> enemy, int swordCount, float radius, float swordSpeed);
+    void spawnEmperorSwordsRadial(Entity* enemy, int swordCount, float radius, float swordSpeed);
     void spawnEnemyGrave(const Vec2<float>& position, bool isEmperor);
     void updateGraves(float deltaTime);
     void updateFragments(float deltaTime);
     void createBlockFragments(const Vec2<float>& position, const std::string & blockType);
     
-    void spawnEmperorSwordsStatic(std::shared_ptr<Entity> emperor,int swordCount,float radius,float speed);
-    void spawnEmperorSwordArmorRadial(std::shared_ptr<Entity> emperor, int swordCount, float radius, float swordSpeed, float baseStopTime, float stopTimeIncrement);
-    void spawnEmperorBulletsRadial(std::shared_ptr<Entity> enemy, int bulletCount, 
+    void spawnEmperorSwordsStatic(Entity* emperor,int swordCount,float radius,float speed);
+    void spawnEmperorSwordArmorRadial(Entity* emperor, int swordCount, float radius, float swordSpeed, float baseStopTime, float stopTimeIncrement);
+    void spawnEmperorBulletsRadial(Entity* enemy, int bulletCount, 
         float radius, float bulletSpeed, 
         const std::string& bulletType);
 
     // Original overload for backward compatibility
-    void spawnEmperorBulletsRadial(std::shared_ptr<Entity> enemy, int bulletCount, 
+    void spawnEmperorBulletsRadial(Entity* enemy, int bulletCount, 
         float radius, float bulletSpeed);
 
-    void spawnEmperorBlackHoles(std::shared_ptr<Entity> enemy, int blackHoleCount, 
+    void spawnEmperorBlackHoles(Entity* enemy, int blackHoleCount, 
         float radius, float blackHoleSpeed);
 
 private:
     GameEngine& m_game;
     EntityManager& m_entityManager;
+    const TileGrid& m_tileGrid;
 };
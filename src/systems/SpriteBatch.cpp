@@ -0,0 +1,66 @@
+#include "SpriteBatch.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+void SpriteBatch::submit(const sf::Texture* texture, const sf::IntRect& textureRect,
+                         const sf::Transform& transform, sf::Color color, int layer) {
+    if (!texture) return;
+
+    // Same geometry sf::Sprite builds (a negative rect size flips the texture)
+    float width  = static_cast<float>(std::abs(textureRect.width));
+    float height = static_cast<float>(std::abs(textureRect.height));
+    sf::Vector2f topLeft     = transform.transformPoint(0.f, 0.f);
+    sf::Vector2f topRight    = transform.transformPoint(width, 0.f);
+    sf::Vector2f bottomLeft  = transform.transformPoint(0.f, height);
+    sf::Vector2f bottomRight = transform.transformPoint(width, height);
+
+    float left   = static_cast<float>(textureRect.left);
+    float right  = left + textureRect.width;
+    float top    = static_cast<float>(textureRect.top);
+    float bottom = top + textureRect.height;
+
+    m_keys.push_back({layer, texture, static_cast<uint32_t>(m_keys.size())});
+    m_submitted.emplace_back(topLeft,     color, sf::Vector2f(left,  top));
+    m_submitted.emplace_back(topRight,    color, sf::Vector2f(right, top));
+    m_submitted.emplace_back(bottomLeft,  color, sf::Vector2f(left,  bottom));
+    m_submitted.emplace_back(bottomLeft,  color, sf::Vector2f(left,  bottom));
+    m_submitted.emplace_back(topRight,    color, sf::Vector2f(right, top));
+    m_submitted.emplace_back(bottomRight, color, sf::Vector2f(right, bottom));
+    ++m_stats.quads;
+}
+
+void SpriteBatch::flush(DrawList& target) {
+    if (m_keys.empty()) return;
+    ++m_stats.flushes;
+
+    std::sort(m_keys.begin(), m_keys.end(), [](const Key& a, const Key& b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (a.texture != b.texture) return std::less<const sf::Texture*>()(a.texture, b.texture);
+        return a.quad < b.quad;
+    });
+
+    m_sorted.clear();
+    for (const Key& key : m_keys) {
+        const sf::Vertex* quad = &m_submitted[static_cast<size_t>(key.quad) * 6];
+        m_sorted.insert(m_sorted.end(), quad, quad + 6);
+    }
+
+    // One draw call per run of the same texture
+    const sf::Texture* lastTexture = nullptr;
+    size_t runStart = 0;
+    for (size_t i = 1; i <= m_keys.size(); ++i) {
+        if (i < m_keys.size() && m_keys[i].texture == m_keys[runStart].texture) continue;
+
+        sf::RenderStates states;
+        states.texture = m_keys[runStart].texture;
+        target.draw(&m_sorted[runStart * 6], (i - runStart) * 6, sf::Triangles, states);
+        ++m_stats.drawCalls;
+        if (lastTexture && lastTexture != states.texture) ++m_stats.textureSwitches;
+        lastTexture = states.texture;
+        runStart = i;
+    }
+
+    m_keys.clear();
+    m_submitted.clear();
+}
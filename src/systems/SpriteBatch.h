@@ -0,0 +1,41 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "DrawList.h"
+#include <vector>
+#include <cstdint>
+
+// Per-frame sprite batch counters (drawn with the bounding boxes, key B)
+struct SpriteBatchStats {
+    size_t quads = 0;             // sprites submitted
+    size_t flushes = 0;           // flush() calls that had something to draw
+    size_t drawCalls = 0;
+    size_t textureSwitches = 0;   // texture changes between consecutive draw calls
+};
+
+// Collects textured quads for the many small moving sprites (bullets, enemy
+// and radial swords, black holes, fragments, collectables) and draws them with
+// as few calls as possible. flush() orders the quads by layer, then texture,
+// keeping submission order inside each (layer, texture) run, and issues one
+// draw call per run. With the atlas pages most layers are a single call.
+class SpriteBatch {
+public:
+    void submit(const sf::Texture* texture, const sf::IntRect& textureRect,
+                const sf::Transform& transform, sf::Color color, int layer = 0);
+    void flush(DrawList& target);
+
+    const SpriteBatchStats& stats() const { return m_stats; }
+    void resetStats() { m_stats = SpriteBatchStats(); }
+
+private:
+    struct Key {
+        int layer;
+        const sf::Texture* texture;
+        uint32_t quad;            // submission order
+    };
+
+    std::vector<Key> m_keys;
+    std::vector<sf::Vertex> m_submitted;   // 6 per quad, submission order
+    std::vector<sf::Vertex> m_sorted;      // same, in draw order
+    SpriteBatchStats m_stats;
+};
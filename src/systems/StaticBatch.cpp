@@ -0,0 +1,264 @@
+#include "StaticBatch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void StaticBatch::clear() {
+    m_slots.clear();
+    m_slotOf.clear();
+    m_chunks.clear();
+    m_originX = 0.f;
+    m_built = false;
+    m_rebuilt = true;
+    m_dirtyRects.clear();
+}
+
+void StaticBatch::build(EntitySpan entities, TintFn tint) {
+    m_tint = std::move(tint);
+    rebuild(entities);
+}
+
+bool StaticBatch::spriteOf(const Entity* entity, sf::Sprite& sprite) {
+    if (!entity->isAlive() || !entity->has<CAnimation>() || !entity->has<CTransform>()) return false;
+    const Animation& animation = entity->get<CAnimation>().animation;
+    if (!animation.getSprite().getTexture()) return false;
+    const auto& pos = entity->get<CTransform>().pos;
+    sprite = animation.getSprite();
+    sprite.setPosition(pos.x, pos.y);
+    sprite.setOrigin(animation.getSize().x / 2.f, animation.getSize().y / 2.f);
+    return true;
+}
+
+StaticBatch::QuadState StaticBatch::stateOf(const Entity* entity, const sf::Sprite& sprite) const {
+    QuadState state;
+    state.textureRect = sprite.getTextureRect();
+    state.position    = sprite.getPosition();
+    state.origin      = sprite.getOrigin();
+    state.scale       = sprite.getScale();
+    state.rotation    = sprite.getRotation();
+    state.color       = m_tint ? m_tint(*entity) : sprite.getColor();
+    return state;
+}
+
+void StaticBatch::rebuild(EntitySpan entities) {
+    m_slots.clear();
+    m_slotOf.clear();
+    m_chunks.clear();
+    m_built = true;
+
+    // First pass: sprites and the level's left edge
+    std::vector<sf::Sprite> sprites(entities.size());
+    std::vector<bool> drawable(entities.size(), false);
+    m_originX = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < entities.size(); ++i) {
+        addSlot(entities[i]->handle());
+        if (!spriteOf(entities[i], sprites[i])) continue;
+        drawable[i] = true;
+        m_originX = std::min(m_originX, sprites[i].getPosition().x);
+    }
+    if (m_originX == std::numeric_limits<float>::max()) m_originX = 0.f;
+
+    // Second pass: one quad per sprite, in group order within each batch
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (drawable[i]) placeQuad(m_slots[i], entities[i], sprites[i]);
+    }
+    m_dirtyRects.clear();   // superseded by the full rebuild
+    m_rebuilt = true;
+}
+
+uint32_t StaticBatch::slotOf(EntityHandle handle) const {
+    if (handle.index() >= m_slotOf.size()) return NPOS;
+    uint32_t slot = m_slotOf[handle.index()];
+    return (slot != NPOS && m_slots[slot].handle == handle) ? slot : NPOS;
+}
+
+uint32_t StaticBatch::addSlot(EntityHandle handle) {
+    uint32_t slot = static_cast<uint32_t>(m_slots.size());
+    m_slots.emplace_back();
+    m_slots.back().handle = handle;
+    if (handle.index() >= m_slotOf.size()) m_slotOf.resize(handle.index() + 1, NPOS);
+    m_slotOf[handle.index()] = slot;
+    return slot;
+}
+
+void StaticBatch::placeQuad(Slot& slot, const Entity* entity, const sf::Sprite& sprite) {
+    // Left of the level's first sprite (spawned later): the first chunk, whose
+    // bounds grow to cover it
+    float offset = (sprite.getPosition().x - m_originX) / CHUNK_WIDTH;
+    uint32_t chunk = offset > 0.f ? static_cast<uint32_t>(offset) : 0;
+    if (chunk >= m_chunks.size()) m_chunks.resize(chunk + 1);
+    auto& batches = m_chunks[chunk].batches;
+    auto it = std::find_if(batches.begin(), batches.end(),
+                           [&](const Batch& b) { return b.texture == sprite.getTexture(); });
+    if (it == batches.end()) {
+        batches.push_back(Batch{sprite.getTexture(), {}});
+        it = batches.end() - 1;
+    }
+
+    slot.chunk       = chunk;
+    slot.batch       = static_cast<uint32_t>(it - batches.begin());
+    slot.firstVertex = static_cast<uint32_t>(it->vertices.size());
+    slot.state       = stateOf(entity, sprite);
+    slot.hidden      = true;   // counted in by writeQuad()
+    it->vertices.resize(it->vertices.size() + 6);
+    writeQuad(slot);
+}
+
+void StaticBatch::sync(EntitySpan entities) {
+    if (!m_built) return;
+    ++m_syncCount;
+
+    sf::Sprite sprite;
+    for (const Entity* entity : entities) {
+        bool shown = spriteOf(entity, sprite);
+        uint32_t index = slotOf(entity->handle());
+        if (index == NPOS) {
+            if (!shown) continue;     // picked up once it has something to draw
+            index = addSlot(entity->handle());
+            m_slots[index].seen = m_syncCount;
+            placeQuad(m_slots[index], entity, sprite);
+            continue;
+        }
+
+        Slot& slot = m_slots[index];
+        slot.seen = m_syncCount;
+        if (slot.chunk == NPOS) {
+            if (shown) placeQuad(slot, entity, sprite);   // got an animation after load
+            continue;
+        }
+        if (!shown) {
+            if (!slot.hidden) {
+                m_dirtyRects.push_back(rectOf(slot.state));
+                collapseQuad(slot);
+            }
+            continue;
+        }
+        if (sprite.getTexture() != m_chunks[slot.chunk].batches[slot.batch].texture) {
+            // Its quad moves to the batch of the new texture
+            if (!slot.hidden) {
+                m_dirtyRects.push_back(rectOf(slot.state));
+                collapseQuad(slot);
+            }
+            placeQuad(slot, entity, sprite);
+            continue;
+        }
+
+        QuadState state = stateOf(entity, sprite);
+        if (slot.hidden || !(state == slot.state)) {
+            if (!slot.hidden) m_dirtyRects.push_back(rectOf(slot.state));
+            slot.state = state;
+            writeQuad(slot);
+        }
+    }
+
+    // Entities that left the group since the last sync (destroyed and
+    // removed by EntityManager::update before we saw them dead)
+    for (uint32_t index = 0; index < m_slots.size(); ++index) {
+        Slot& slot = m_slots[index];
+        if (slot.seen == m_syncCount || !slot.handle.isValid()) continue;
+        if (slot.chunk != NPOS && !slot.hidden) {
+            m_dirtyRects.push_back(rectOf(slot.state));
+            collapseQuad(slot);
+        }
+        if (m_slotOf[slot.handle.index()] == index) m_slotOf[slot.handle.index()] = NPOS;
+        slot.handle = EntityHandle();
+    }
+}
+
+// Same transform sf::Sprite builds
+sf::Transform StaticBatch::transformOf(const QuadState& s) {
+    sf::Transform transform;
+    transform.translate(s.position).rotate(s.rotation).scale(s.scale).translate(-s.origin);
+    return transform;
+}
+
+sf::FloatRect StaticBatch::rectOf(const QuadState& s) {
+    float width  = static_cast<float>(std::abs(s.textureRect.width));
+    float height = static_cast<float>(std::abs(s.textureRect.height));
+    return transformOf(s).transformRect({0.f, 0.f, width, height});
+}
+
+void StaticBatch::writeQuad(Slot& slot) {
+    Chunk& chunk = m_chunks[slot.chunk];
+    sf::Vertex* quad = &chunk.batches[slot.batch].vertices[slot.firstVertex];
+    const QuadState& s = slot.state;
+
+    // Same geometry sf::Sprite builds (a negative rect size flips the texture)
+    sf::Transform transform = transformOf(s);
+    float width  = static_cast<float>(std::abs(s.textureRect.width));
+    float height = static_cast<float>(std::abs(s.textureRect.height));
+    sf::Vector2f topLeft     = transform.transformPoint(0.f, 0.f);
+    sf::Vector2f topRight    = transform.transformPoint(width, 0.f);
+    sf::Vector2f bottomLeft  = transform.transformPoint(0.f, height);
+    sf::Vector2f bottomRight = transform.transformPoint(width, height);
+
+    float left   = static_cast<float>(s.textureRect.left);
+    float right  = left + s.textureRect.width;
+    float top    = static_cast<float>(s.textureRect.top);
+    float bottom = top + s.textureRect.height;
+
+    quad[0] = sf::Vertex(topLeft,     s.color, {left,  top});
+    quad[1] = sf::Vertex(topRight,    s.color, {right, top});
+    quad[2] = sf::Vertex(bottomLeft,  s.color, {left,  bottom});
+    quad[3] = sf::Vertex(bottomLeft,  s.color, {left,  bottom});
+    quad[4] = sf::Vertex(topRight,    s.color, {right, top});
+    quad[5] = sf::Vertex(bottomRight, s.color, {right, bottom});
+    if (slot.hidden) ++chunk.sprites;
+    slot.hidden = false;
+
+    // Chunk bounds only grow; they are used for culling
+    sf::FloatRect rect = transform.transformRect({0.f, 0.f, width, height});
+    m_dirtyRects.push_back(rect);
+    if (chunk.bounds.width == 0.f && chunk.bounds.height == 0.f) {
+        chunk.bounds = rect;
+    } else {
+        float minX = std::min(chunk.bounds.left, rect.left);
+        float minY = std::min(chunk.bounds.top, rect.top);
+        float maxX = std::max(chunk.bounds.left + chunk.bounds.width, rect.left + rect.width);
+        float maxY = std::max(chunk.bounds.top + chunk.bounds.height, rect.top + rect.height);
+        chunk.bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+    }
+}
+
+void StaticBatch::collapseQuad(Slot& slot) {
+    if (slot.hidden) return;
+    Chunk& chunk = m_chunks[slot.chunk];
+    sf::Vertex* quad = &chunk.batches[slot.batch].vertices[slot.firstVertex];
+    for (int v = 0; v < 6; ++v) {
+        quad[v].position = quad[0].position;   // zero area: nothing rasterised
+    }
+    --chunk.sprites;
+    slot.hidden = true;
+}
+
+void StaticBatch::draw(DrawList& target, const sf::FloatRect& area, RenderStats& stats) const {
+    for (const Chunk& chunk : m_chunks) {
+        if (chunk.sprites == 0) continue;
+        if (!chunk.bounds.intersects(area)) {
+            stats.culled += chunk.sprites;
+            continue;
+        }
+        stats.drawn += chunk.sprites;
+        for (const Batch& batch : chunk.batches) {
+            sf::RenderStates states;
+            states.texture = batch.texture;
+            target.draw(batch.vertices.data(), batch.vertices.size(), sf::Triangles, states);
+            ++stats.batchCalls;
+        }
+    }
+}
+
+bool StaticBatch::takeChanges(std::vector<sf::FloatRect>& dirty) {
+    bool rebuilt = m_rebuilt;
+    if (!rebuilt) dirty.insert(dirty.end(), m_dirtyRects.begin(), m_dirtyRects.end());
+    m_dirtyRects.clear();
+    m_rebuilt = false;
+    return rebuilt;
+}
+
+void StaticBatch::coverage(std::vector<sf::FloatRect>& rects) const {
+    for (const Slot& slot : m_slots) {
+        if (slot.chunk == NPOS || slot.hidden) continue;
+        rects.push_back(rectOf(slot.state));
+    }
+}
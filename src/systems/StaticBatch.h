@@ -0,0 +1,118 @@
+#pragma once
+
+#include "EntityManager.hpp"
+#include "TileGrid.hpp"
+#include "Animation.hpp"
+#include "DrawList.h"
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <vector>
+#include <cstdint>
+
+// Per-frame render counters (drawn with the bounding boxes, key B)
+struct RenderStats {
+    size_t drawn = 0;            // sprites inside the culling rect
+    size_t culled = 0;           // sprites skipped
+    size_t batchCalls = 0;       // draw calls issued by the static batches
+    size_t chunksComposited = 0; // cached static chunks drawn as one quad each
+    size_t chunkRedraws = 0;     // ...and those re-rendered because they were dirty
+};
+
+// Vertex-array batching for the layers that (almost) never move: tiles and
+// decorations. At level load every sprite becomes two triangles in one vertex
+// array per texture per chunk (a strip of level CHUNK_WIDTH wide), tinted once.
+// Drawing is then one call per texture of each chunk under the view instead of
+// one call per sprite.
+//
+// sync() re-reads the entities every frame and rewrites only the quads whose
+// frame, position or colour changed (animated tiles, treasure hit). Slots are
+// found by EntityHandle, so the group's order doesn't matter: a destroyed
+// entity's quad is collapsed in place, a new entity (or one that switched
+// texture) gets a quad appended to its chunk. Only build() (level load)
+// rebuilds. Stored pointers are never dereferenced.
+// Every rewritten quad is reported (old and new rect) through takeChanges(),
+// which is what LayerCompositor uses to know which cached chunks to redraw.
+class StaticBatch {
+public:
+    static constexpr float CHUNK_WIDTH = 16.f * TileGrid::CELL_SIZE;
+
+    // Colour an entity's sprite is drawn with (time-of-day grading)
+    using TintFn = std::function<sf::Color(const Entity&)>;
+
+    void clear();
+    void build(EntitySpan entities, TintFn tint);
+    void sync(EntitySpan entities);
+    bool built() const { return m_built; }
+
+    // Draws the chunks intersecting `area`
+    void draw(DrawList& target, const sf::FloatRect& area, RenderStats& stats) const;
+
+    // Appends the world rects whose pixels changed since the last call.
+    // Returns true instead when the batch was rebuilt: everything changed.
+    bool takeChanges(std::vector<sf::FloatRect>& dirty);
+    // World rects of all the quads currently drawn
+    void coverage(std::vector<sf::FloatRect>& rects) const;
+
+private:
+    static constexpr uint32_t NPOS = 0xFFFFFFFFu;
+
+    // Everything a quad is written from
+    struct QuadState {
+        sf::IntRect textureRect;
+        sf::Vector2f position;
+        sf::Vector2f origin;
+        sf::Vector2f scale;
+        float rotation = 0.f;
+        sf::Color color;
+
+        bool operator==(const QuadState& o) const {
+            return textureRect == o.textureRect && position == o.position && origin == o.origin &&
+                   scale == o.scale && rotation == o.rotation && color == o.color;
+        }
+    };
+
+    struct Slot {
+        EntityHandle handle;       // invalid once the entity left the group
+        uint32_t chunk = NPOS;     // NPOS: no quad yet (nothing to draw so far)
+        uint32_t batch = 0;
+        uint32_t firstVertex = 0;
+        uint32_t seen = 0;         // last sync() that found the entity
+        bool hidden = false;       // collapsed (entity died)
+        QuadState state;
+    };
+
+    struct Batch {
+        const sf::Texture* texture = nullptr;
+        std::vector<sf::Vertex> vertices;   // sf::Triangles, 6 per sprite
+    };
+
+    struct Chunk {
+        sf::FloatRect bounds;
+        size_t sprites = 0;
+        std::vector<Batch> batches;
+    };
+
+    void rebuild(EntitySpan entities);
+    uint32_t slotOf(EntityHandle handle) const;
+    uint32_t addSlot(EntityHandle handle);
+    // Appends a quad for the sprite to its chunk's batch (the slot's old quad,
+    // if any, must be collapsed)
+    void placeQuad(Slot& slot, const Entity* entity, const sf::Sprite& sprite);
+    // Sprite exactly as PlayRenderer used to draw it (centred on the transform)
+    static bool spriteOf(const Entity* entity, sf::Sprite& sprite);
+    QuadState stateOf(const Entity* entity, const sf::Sprite& sprite) const;
+    static sf::Transform transformOf(const QuadState& state);
+    static sf::FloatRect rectOf(const QuadState& state);
+    void writeQuad(Slot& slot);
+    void collapseQuad(Slot& slot);
+
+    TintFn m_tint;
+    std::vector<Slot> m_slots;     // build order, then appended
+    std::vector<uint32_t> m_slotOf; // slot by handle index (NPOS: none)
+    std::vector<Chunk> m_chunks;
+    float m_originX = 0.f;
+    uint32_t m_syncCount = 0;
+    bool m_built = false;
+    bool m_rebuilt = false;                  // since the last takeChanges()
+    std::vector<sf::FloatRect> m_dirtyRects;
+};